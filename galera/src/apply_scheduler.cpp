@@ -0,0 +1,105 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+#include "apply_scheduler.hpp"
+
+#include <gu_logger.hpp>
+#include <gu_utils.hpp>
+
+galera::ApplyScheduler::ApplyScheduler()
+    :
+    mutex_       (),
+    cond_        (),
+    trxs_        (),
+    last_left_   (-1),
+    waiters_     (0),
+    size_        (0),
+    parked_total_(0),
+    enabled_     (false)
+{}
+
+galera::ApplyScheduler::~ApplyScheduler()
+{
+    if (!trxs_.empty())
+    {
+        log_warn << "Discarding " << trxs_.size() << " parked write-sets";
+
+        for (TrxMap::iterator i(trxs_.begin()); i != trxs_.end(); ++i)
+        {
+            i->second->unref();
+        }
+    }
+}
+
+void
+galera::ApplyScheduler::left(wsrep_seqno_t const last_left)
+{
+    gu::Lock lock(mutex_);
+
+    last_left_ = last_left;
+
+    if (waiters_ > 0 && !trxs_.empty() &&
+        trxs_.begin()->second->depends_seqno() <= last_left_)
+    {
+        cond_.signal();
+    }
+}
+
+bool
+galera::ApplyScheduler::park(TrxHandle* const trx)
+{
+    assert(!trx->is_local());
+
+    gu::Lock lock(mutex_);
+
+    if (trx->depends_seqno() <= last_left_) return false;
+
+    trx->ref();
+    trxs_.insert(std::make_pair(trx->global_seqno(), trx));
+    ++size_;
+    ++parked_total_;
+
+    // the new trx may be lower than the one waited for
+    if (waiters_ > 0) cond_.signal();
+
+    return true;
+}
+
+galera::TrxHandle*
+galera::ApplyScheduler::next()
+{
+    gu::Lock lock(mutex_);
+
+    while (!trxs_.empty())
+    {
+        TrxMap::iterator const i(trxs_.begin());
+        TrxHandle* const       trx(i->second);
+
+        if (trx->depends_seqno() <= last_left_)
+        {
+            trxs_.erase(i);
+            --size_;
+
+            // waiter, if any, needs to look at the new lowest trx
+            if (waiters_ > 0) cond_.signal();
+
+            return trx;
+        }
+
+        if (waiters_ > 0) break; // somebody already waits for it
+
+        ++waiters_;
+        lock.wait(cond_);
+        --waiters_;
+    }
+
+    return 0;
+}
+
+void
+galera::ApplyScheduler::get_status(gu::Status& status) const
+{
+    status.insert("apply_sched_parked", gu::to_string(parked_total_()));
+    status.insert("apply_sched_queue",  gu::to_string(size_()));
+}
@@ -0,0 +1,98 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+/*
+ * Optional dependency-aware scheduling of slave write-sets.
+ *
+ * Without it a slave thread which has certified a write-set enters apply
+ * monitor and sleeps there until the write-set it depends on (as found by
+ * certification) leaves the monitor, while independent write-sets queue up
+ * behind it in the recv queue.
+ *
+ * With scheduling enabled such a write-set is parked here instead and the
+ * thread goes on to the next action. Parked write-sets form a queue ordered
+ * by global seqno and are taken by the first slave thread which becomes free
+ * once the lowest of them is ready (its dependency has left apply monitor).
+ *
+ * Since write-sets commit in order, a thread applying a later write-set may
+ * end up waiting in commit monitor for a parked one. To rule out deadlock
+ * parked write-sets are handed out strictly in seqno order and, while there
+ * are any, one free thread stays here waiting for them instead of blocking
+ * in the recv queue.
+ */
+
+#ifndef GALERA_APPLY_SCHEDULER_HPP
+#define GALERA_APPLY_SCHEDULER_HPP
+
+#include "trx_handle.hpp"
+
+#include <gu_lock.hpp>
+#include <gu_atomic.hpp>
+#include <gu_status.hpp>
+
+#include <map>
+
+namespace galera
+{
+    class ApplyScheduler
+    {
+    public:
+
+        ApplyScheduler();
+
+        ~ApplyScheduler();
+
+        bool enabled() const { return enabled_; }
+
+        /*! can be changed only before slave threads are started */
+        void set_enabled(bool val) { enabled_ = val; }
+
+        /*! to be installed as apply monitor Monitor::LeftCb */
+        static void left_cb(void* ctx, wsrep_seqno_t const last_left)
+        {
+            static_cast<ApplyScheduler*>(ctx)->left(last_left);
+        }
+
+        /*! updates last seqno which left apply monitor */
+        void left(wsrep_seqno_t last_left);
+
+        /*! Parks certified slave trx if its dependency has not left apply
+         *  monitor yet. Parked trx is referenced until returned by next().
+         *  @return false if trx can be applied right away */
+        bool park(TrxHandle* trx);
+
+        /*! @return the lowest parked trx once it is ready to be applied or
+         *          0 if the calling thread should go for the next action.
+         *          Blocks if there are parked trxs and no other thread is
+         *          waiting for them. */
+        TrxHandle* next();
+
+        /*! number of currently parked trxs */
+        long parked() const { return size_(); }
+
+        /*! adds "apply_sched_parked" - number of trxs parked since last
+         *  reset and "apply_sched_queue" - number of currently parked trxs */
+        void get_status(gu::Status& status) const;
+
+        void reset() { parked_total_ = 0; }
+
+    private:
+
+        typedef std::map<wsrep_seqno_t, TrxHandle*> TrxMap;
+
+        gu::Mutex             mutex_;
+        gu::Cond              cond_;
+        TrxMap                trxs_;
+        wsrep_seqno_t         last_left_;
+        int                   waiters_;
+        gu::Atomic<long>      size_;
+        gu::Atomic<long long> parked_total_;
+        bool                  enabled_;
+
+        ApplyScheduler(const ApplyScheduler&);
+        ApplyScheduler& operator=(const ApplyScheduler&);
+    };
+}
+
+#endif /* GALERA_APPLY_SCHEDULER_HPP */
@@ -764,11 +764,10 @@ galera::Certification::do_test(TrxHandle* trx, bool store_keys)
     if (store_keys == true && res == TEST_OK)
     {
         ++trx_count_;
-        gu::Lock lock(stats_mutex_);
-        ++n_certified_;
         deps_dist_ += (trx->global_seqno() - trx->depends_seqno());
         cert_interval_ += (trx->global_seqno() - trx->last_seen_seqno() - 1);
         index_size_ = (cert_index_.size() + cert_index_ng_.size());
+        ++n_certified_;
     }
 
     byte_count_ += trx->size();
@@ -837,11 +836,6 @@ galera::Certification::Certification(gu::Config& conf, ServiceThd& thd)
     last_pa_unsafe_        (-1),
     last_preordered_seqno_ (position_),
     last_preordered_id_    (0),
-#ifdef HAVE_PSI_INTERFACE
-    stats_mutex_           (WSREP_PFS_INSTR_TAG_STATS_MUTEX),
-#else
-    stats_mutex_           (),
-#endif /* HAVE_PSI_INTERFACE */
     n_certified_           (0),
     deps_dist_             (0),
     cert_interval_         (0),
@@ -852,7 +846,8 @@ galera::Certification::Certification(gu::Config& conf, ServiceThd& thd)
 
     max_length_            (max_length(conf)),
     max_length_check_      (length_check(conf)),
-    log_conflicts_         (conf.get<bool>(CERT_PARAM_LOG_CONFLICTS))
+    log_conflicts_         (conf.get<bool>(CERT_PARAM_LOG_CONFLICTS)),
+    prof_                  ("certification")
 {}
 
 
@@ -869,6 +864,9 @@ galera::Certification::~Certification()
     log_info << "avg deps dist "              << avg_deps_dist;
     log_info << "avg cert interval "          << avg_cert_interval;
     log_info << "cert index size "            << index_size;
+#ifdef GU_PROFILE
+    log_info << prof_;
+#endif // GU_PROFILE
 
     gu::Lock lock(mutex_);
 
@@ -937,8 +935,11 @@ galera::Certification::test(TrxHandle* trx, bool bval)
 {
     assert(trx->global_seqno() >= 0 && trx->local_seqno() >= 0);
 
-    const TestResult ret
-        (trx->preordered() ? do_test_preordered(trx) : do_test(trx, bval));
+    TestResult ret;
+
+    profile_enter(prof_);
+    ret = (trx->preordered() ? do_test_preordered(trx) : do_test(trx, bval));
+    profile_leave(prof_);
 
     if (gu_unlikely(ret != TEST_OK))
     {
@@ -976,8 +977,10 @@ galera::Certification::purge_trxs_upto_(wsrep_seqno_t const seqno,
 
     cert_debug << "purging index up to " << seqno;
 
+    profile_enter(prof_);
     for_each(trx_map_.begin(), purge_bound, PurgeAndDiscard(*this));
     trx_map_.erase(trx_map_.begin(), purge_bound);
+    profile_leave(prof_);
 
     if (handle_gcache) service_thd_.release_seqno(seqno);
 
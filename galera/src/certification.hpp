@@ -11,6 +11,8 @@
 
 #include "gu_unordered.hpp"
 #include "gu_lock.hpp"
+#include "gu_atomic.hpp"
+#include "gu_profile.hpp"
 #include "gu_config.hpp"
 
 #include <map>
@@ -81,27 +83,29 @@ namespace galera
         TrxHandle* get_trx(wsrep_seqno_t);
 
         // statistics section
+        // Statistics are updated by certification only and read without
+        // locking, so reading them never delays certification. Values
+        // read concurrently with an update may be off by one trx.
         void stats_get(double& avg_cert_interval,
                        double& avg_deps_dist,
                        size_t& index_size) const
         {
-            gu::Lock lock(stats_mutex_);
             avg_cert_interval = 0;
             avg_deps_dist = 0;
-            if (n_certified_)
+            long long const n_certified(n_certified_());
+            if (n_certified)
             {
-                avg_cert_interval = double(cert_interval_) / n_certified_;
-                avg_deps_dist = double(deps_dist_) / n_certified_;
+                avg_cert_interval = double(cert_interval_()) / n_certified;
+                avg_deps_dist = double(deps_dist_()) / n_certified;
             }
-            index_size = index_size_;
+            index_size = index_size_();
         }
 
         void stats_reset()
         {
-            gu::Lock lock(stats_mutex_);
+            n_certified_ = 0;
             cert_interval_ = 0;
             deps_dist_ = 0;
-            n_certified_ = 0;
             index_size_ = 0;
         }
 
@@ -202,16 +206,10 @@ namespace galera
         wsrep_seqno_t last_pa_unsafe_;
         wsrep_seqno_t last_preordered_seqno_;
         wsrep_trx_id_t last_preordered_id_;
-#ifdef HAVE_PSI_INTERFACE
-        gu::MutexWithPFS
-                      stats_mutex_;
-#else
-        gu::Mutex     stats_mutex_;
-#endif /* HAVE_PSI_INTERFACE */
-        size_t        n_certified_;
-        wsrep_seqno_t deps_dist_;
-        wsrep_seqno_t cert_interval_;
-        size_t        index_size_;
+        gu::Atomic<long long> n_certified_;
+        gu::Atomic<long long> deps_dist_;
+        gu::Atomic<long long> cert_interval_;
+        gu::Atomic<size_t>    index_size_;
 
         size_t        key_count_;
         size_t        byte_count_;
@@ -227,6 +225,8 @@ namespace galera
         unsigned int const max_length_check_; /* Mask how often to check */
 
         bool               log_conflicts_;
+
+        gu::prof::Profile  prof_;
     };
 }
 
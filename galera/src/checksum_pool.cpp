@@ -0,0 +1,288 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+#include "checksum_pool.hpp"
+
+#include "gu_time.h"
+
+#ifdef HAVE_PSI_INTERFACE
+#include "wsrep_api.h"
+#endif /* HAVE_PSI_INTERFACE */
+
+#include <algorithm>
+#include <cassert>
+
+namespace galera
+{
+
+bool
+ChecksumPool::Handle::wait() const
+{
+    gu::Lock lock(mtx_);
+
+    while (pending_ > 0) lock.wait(cond_);
+
+    return !failed_;
+}
+
+void
+ChecksumPool::Handle::done(bool const ok)
+{
+    gu::Lock lock(mtx_);
+
+    assert(pending_ > 0);
+
+    failed_ = failed_ || !ok;
+
+    if (0 == --pending_) cond_.broadcast();
+}
+
+
+ChecksumPool&
+ChecksumPool::instance()
+{
+    static ChecksumPool pool;
+    return pool;
+}
+
+
+ChecksumPool::ChecksumPool (int const max_threads)
+    :
+    mtx_        (),
+    cond_       (),
+    queue_      (),
+    threads_    (),
+    exited_     (),
+    max_threads_(std::max(max_threads, 0)),
+    running_    (0),
+    idle_       (0),
+    exiting_    (0),
+    jobs_       (0),
+    inline_     (0),
+    busy_ns_    (0),
+    stats_start_(gu_time_monotonic()),
+    closing_    (false)
+{}
+
+
+ChecksumPool::~ChecksumPool ()
+{
+    {
+        gu::Lock lock(mtx_);
+        closing_ = true;
+        cond_.broadcast();
+    }
+
+    for (size_t i(0); i < threads_.size(); ++i)
+    {
+        gu_thread_join(threads_[i], NULL);
+    }
+
+    join_exited();
+
+    assert(queue_.empty());
+}
+
+
+void
+ChecksumPool::run_job (Job& job)
+{
+    Handle* const handle(job.handle_);
+    job.handle_ = NULL;
+
+    bool const ok(job.run());
+
+    handle->done(ok);
+}
+
+
+void
+ChecksumPool::submit (Job& job, Handle& handle)
+{
+    assert(NULL == job.handle_);
+
+    job.handle_ = &handle;
+    handle.add();
+
+    {
+        gu::Lock lock(mtx_);
+
+        if (gu_likely(!closing_))
+        {
+            if (gu_unlikely(!exited_.empty())) join_exited();
+
+            if (idle_ <= int(queue_.size()) && running_ < max_threads_)
+            {
+                gu_thread_t thd;
+                int const err(gu_thread_create(&thd, NULL, thd_func, this));
+
+                if (gu_likely(0 == err))
+                {
+                    threads_.push_back(thd);
+                    ++running_;
+                }
+                else
+                {
+                    log_warn << "Starting checksum thread failed: " << err
+                             << '(' << ::strerror(err) << ')';
+                }
+            }
+
+            if (gu_likely(running_ > 0))
+            {
+                queue_.push_back(&job);
+                if (idle_ > 0) cond_.signal();
+                return;
+            }
+        }
+
+        ++inline_;
+    }
+
+    /* no workers available, run in foreground */
+    run_job(job);
+}
+
+
+void
+ChecksumPool::set_max_threads (int const n)
+{
+    gu::Lock lock(mtx_);
+
+    max_threads_ = std::max(n, 0);
+
+    int const excess(running_ - exiting_ - max_threads_);
+
+    if (excess > 0)
+    {
+        exiting_ += excess;
+        cond_.broadcast();
+    }
+
+    join_exited();
+}
+
+
+void
+ChecksumPool::join_exited ()
+{
+    /* exited threads don't need mtx_ anymore, so they can be joined
+     * while it is held */
+    for (size_t i(0); i < exited_.size(); ++i)
+    {
+        gu_thread_join(exited_[i], NULL);
+    }
+
+    exited_.clear();
+}
+
+
+void
+ChecksumPool::get_stats (Stats& stats) const
+{
+    gu::Lock lock(mtx_);
+
+    long long const now(gu_time_monotonic());
+    long long const period((now - stats_start_) * std::max(running_, 1));
+
+    stats.jobs_        = jobs_;
+    stats.inline_      = inline_;
+    stats.utilization_ = period > 0 ? double(busy_ns_)/period : 0.0;
+    stats.threads_     = running_;
+    stats.max_threads_ = max_threads_;
+    stats.queue_       = queue_.size();
+}
+
+
+void
+ChecksumPool::flush_stats ()
+{
+    gu::Lock lock(mtx_);
+
+    jobs_        = 0;
+    inline_      = 0;
+    busy_ns_     = 0;
+    stats_start_ = gu_time_monotonic();
+}
+
+
+void
+ChecksumPool::run_worker ()
+{
+    gu::Lock lock(mtx_);
+
+    while (true)
+    {
+        while (queue_.empty() && !closing_ && 0 == exiting_)
+        {
+            ++idle_;
+            lock.wait(cond_);
+            --idle_;
+        }
+
+        if (queue_.empty())
+        {
+            if (closing_) break;
+
+            if (exiting_ > 0)
+            {
+                /* hand own thread handle over to be joined by the next
+                 * submit() or set_max_threads() call or destructor */
+                --exiting_;
+
+                gu_thread_t const self(pthread_self());
+                for (size_t i(0); i < threads_.size(); ++i)
+                {
+                    if (pthread_equal(threads_[i], self))
+                    {
+                        exited_.push_back(threads_[i]);
+                        threads_.erase(threads_.begin() + i);
+                        break;
+                    }
+                }
+
+                break;
+            }
+        }
+
+        Job* const job(queue_.front());
+        queue_.pop_front();
+
+        long long const start(gu_time_monotonic());
+
+        mtx_.unlock();
+        run_job(*job);
+        mtx_.lock();
+
+        busy_ns_ += gu_time_monotonic() - start;
+        ++jobs_;
+    }
+
+    --running_;
+}
+
+
+void*
+ChecksumPool::thd_func (void* arg)
+{
+#ifdef HAVE_PSI_INTERFACE
+    pfs_instr_callback(WSREP_PFS_INSTR_TYPE_THREAD,
+                       WSREP_PFS_INSTR_OPS_INIT,
+                       WSREP_PFS_INSTR_TAG_WRITESET_CHECKSUM_THREAD,
+                       NULL, NULL, NULL);
+#endif /* HAVE_PSI_INTERFACE */
+
+    static_cast<ChecksumPool*>(arg)->run_worker();
+
+#ifdef HAVE_PSI_INTERFACE
+    pfs_instr_callback(WSREP_PFS_INSTR_TYPE_THREAD,
+                       WSREP_PFS_INSTR_OPS_DESTROY,
+                       WSREP_PFS_INSTR_TAG_WRITESET_CHECKSUM_THREAD,
+                       NULL, NULL, NULL);
+#endif /* HAVE_PSI_INTERFACE */
+
+    return NULL;
+}
+
+} /* namespace galera */
@@ -0,0 +1,145 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+/*
+ * Process-wide pool of worker threads used to verify checksums of big
+ * writesets in background.
+ *
+ * Submitter splits the work into independent jobs (e.g. one per record set),
+ * submits them with a completion Handle and later waits on the handle.
+ * Worker threads are started lazily on demand up to a configured maximum and
+ * are kept around for subsequent jobs.
+ */
+
+#ifndef GALERA_CHECKSUM_POOL_HPP
+#define GALERA_CHECKSUM_POOL_HPP
+
+#include <gu_lock.hpp> // gu::Mutex and gu::Cond
+
+#include <deque>
+#include <vector>
+
+namespace galera
+{
+    class ChecksumPool
+    {
+    public:
+
+        class Handle;
+
+        class Job
+        {
+        public:
+
+            Job() : handle_(NULL) {}
+            virtual ~Job() {}
+
+            /*! performs the job, returns false on checksum failure.
+             *  Must not throw. */
+            virtual bool run() = 0;
+
+        private:
+
+            friend class ChecksumPool;
+            Handle* handle_;
+
+            Job (const Job&);
+            Job& operator= (const Job&);
+        };
+
+        /*! Completion handle for a group of jobs submitted by one owner */
+        class Handle
+        {
+        public:
+
+            Handle() : mtx_(), cond_(), pending_(0), failed_(false) {}
+
+            ~Handle() { wait(); }
+
+            /*! waits for all submitted jobs to complete,
+             *  returns true if all of them succeeded */
+            bool wait() const;
+
+            bool pending() const { gu::Lock lock(mtx_); return pending_ > 0; }
+
+        private:
+
+            friend class ChecksumPool;
+
+            void add()          { gu::Lock lock(mtx_); ++pending_; }
+            void done(bool ok);
+
+            gu::Mutex   mtx_;
+            gu::Cond    cond_;
+            int         pending_;
+            bool        failed_;
+
+            Handle (const Handle&);
+            Handle& operator= (const Handle&);
+        };
+
+        struct Stats
+        {
+            long long jobs_;        // jobs completed since last reset
+            long long inline_;      // jobs run in submitter thread
+            double    utilization_; // busy time fraction of worker threads
+            int       threads_;     // worker threads running
+            int       max_threads_; // maximum allowed worker threads
+            int       queue_;       // jobs waiting for a worker
+        };
+
+        /*! process-wide instance */
+        static ChecksumPool& instance();
+
+        explicit ChecksumPool (int max_threads = DEFAULT_MAX_THREADS);
+
+        ~ChecksumPool ();
+
+        /*! queues job for execution, job object must stay valid till
+         *  handle.wait() returns. If no worker can be made available, job
+         *  is executed in the calling thread. */
+        void submit (Job& job, Handle& handle);
+
+        /*! changes worker thread limit. Excess threads exit when idle. */
+        void set_max_threads (int n);
+
+        void get_stats (Stats& stats) const;
+
+        void flush_stats ();
+
+        static int const DEFAULT_MAX_THREADS = 4;
+
+    private:
+
+        mutable gu::Mutex  mtx_;
+        gu::Cond           cond_;
+        std::deque<Job*>   queue_;
+        std::vector<gu_thread_t> threads_; // running worker threads
+        std::vector<gu_thread_t> exited_;  // exited, to be joined
+        int                max_threads_;
+        int                running_;    // threads running
+        int                idle_;       // threads waiting for work
+        int                exiting_;    // threads asked to exit
+        long long          jobs_;
+        long long          inline_;
+        long long          busy_ns_;
+        long long          stats_start_;
+        bool               closing_;
+
+        static void* thd_func (void* arg);
+
+        void run_worker ();
+
+        /*! joins threads which exited on set_max_threads(),
+         *  to be called with mtx_ locked */
+        void join_exited ();
+
+        static void run_job (Job& job);
+
+        ChecksumPool (const ChecksumPool&);
+        ChecksumPool& operator= (const ChecksumPool&);
+    };
+}
+
+#endif /* GALERA_CHECKSUM_POOL_HPP */
@@ -4,3 +4,173 @@
 
 #include "data_set.hpp"
 
+#include "gu_serialize.hpp"
+#include "gu_logger.hpp"
+
+#include <zlib.h>
+
+#include <cstring>
+
+namespace galera
+{
+
+/* uncompressed size + packing method */
+static size_t const ZLIB_TRAILER_SIZE = 4 + 1;
+
+ssize_t
+DataSetOut::gather (GatherVector& out)
+{
+    /* neither trailer nor record set header may be written twice */
+    if (gathered_size_ >= 0)
+    {
+        out->insert (out->end(), gathered_.begin(), gathered_.end());
+        return gathered_size_;
+    }
+
+    if (DataSet::VER2 == version_ && count() > 0)
+    {
+        size_t psize(0);
+        for (size_t i(0); i < payload_.size(); ++i) psize += payload_[i].size;
+
+        if (0 == threshold_ || psize < threshold_ || !compress(psize))
+        {
+            gu::byte_t const trailer(DataSet::PACK_NONE);
+            gu::RecordSetOut<DataSet::RecordOut>::append(&trailer,
+                                                         sizeof(trailer),
+                                                         true, false);
+        }
+    }
+
+    size_t const begin(out->size());
+
+    gathered_size_ = (NULL != zset_ ? zset_->gather(out) :
+                      gu::RecordSetOut<DataSet::RecordOut>::gather(out));
+
+    gathered_.assign (out->begin() + begin, out->end());
+
+    return gathered_size_;
+}
+
+
+bool
+DataSetOut::compress (size_t const psize)
+{
+    if (gu_unlikely(psize > 0xffffffff)) return false;
+
+    z_stream zs;
+    ::memset(&zs, 0, sizeof(zs));
+
+    int err(deflateInit(&zs, Z_BEST_SPEED));
+
+    if (gu_unlikely(Z_OK != err))
+    {
+        log_warn << "Failed to initialize data set compression: " << err;
+        return false;
+    }
+
+    zbuf_.resize(deflateBound(&zs, psize) + ZLIB_TRAILER_SIZE);
+
+    zs.next_out  = &zbuf_[0];
+    zs.avail_out = zbuf_.size() - ZLIB_TRAILER_SIZE;
+
+    for (size_t i(0); Z_OK == err && i < payload_.size(); ++i)
+    {
+        zs.next_in  = static_cast<Bytef*>(const_cast<void*>(payload_[i].ptr));
+        zs.avail_in = payload_[i].size;
+
+        err = deflate(&zs, Z_NO_FLUSH);
+
+        /* output buffer is big enough to always consume all input */
+        if (zs.avail_in > 0) err = Z_BUF_ERROR;
+    }
+
+    if (Z_OK == err) err = deflate(&zs, Z_FINISH);
+
+    size_t const zsize(zs.total_out);
+
+    deflateEnd(&zs);
+
+    if (Z_STREAM_END != err || zsize + ZLIB_TRAILER_SIZE >= psize)
+    {
+        /* failed or not worth it, send payload as is */
+        std::vector<gu::byte_t>().swap(zbuf_);
+        return false;
+    }
+
+    size_t off(gu::serialize4(uint32_t(psize), &zbuf_[0], zbuf_.size(),
+                              zsize));
+    off = gu::serialize1(uint8_t(DataSet::PACK_ZLIB), &zbuf_[0], zbuf_.size(),
+                         off);
+
+    zset_ = new gu::RecordSetOut<DataSet::RecordOut>(NULL, 0, *base_name_,
+                                                     check_type_,
+                                                     gu::RecordSet::VER1);
+    zset_->append(&zbuf_[0], off, false, false);
+
+    return true;
+}
+
+
+gu::Buf
+DataSetIn::unpack (const gu::Buf& rec) const
+{
+    const gu::byte_t* const ptr(static_cast<const gu::byte_t*>(rec.ptr));
+
+    if (gu_unlikely(rec.size < 1))
+    {
+        gu_throw_error(EINVAL) << "Data set payload too short: " << rec.size;
+    }
+
+    ssize_t const size(rec.size - 1);
+
+    switch (ptr[size])
+    {
+    case DataSet::PACK_NONE:
+    {
+        gu::Buf const ret = { ptr, size };
+        return ret;
+    }
+    case DataSet::PACK_ZLIB:
+    {
+        if (unpacked_.empty())
+        {
+            uint32_t usize(0);
+            ssize_t const zsize(size - sizeof(usize));
+
+            if (gu_unlikely(zsize <= 0))
+            {
+                gu_throw_error(EINVAL) << "Compressed data set payload too "
+                                       << "short: " << rec.size;
+            }
+
+            gu::unserialize4(ptr, size, zsize, usize);
+
+            if (gu_unlikely(0 == usize))
+            {
+                gu_throw_error(EINVAL) << "Zero uncompressed data set size";
+            }
+
+            unpacked_.resize(usize);
+
+            uLongf dlen(usize);
+            int const err(uncompress(&unpacked_[0], &dlen, ptr, zsize));
+
+            if (gu_unlikely(Z_OK != err || dlen != usize))
+            {
+                unpacked_.clear();
+                gu_throw_error(EINVAL) << "Failed to decompress data set: "
+                                       << err << ", size " << dlen
+                                       << ", expected " << usize;
+            }
+        }
+
+        gu::Buf const ret = { &unpacked_[0], ssize_t(unpacked_.size()) };
+        return ret;
+    }
+    }
+
+    gu_throw_error(EPROTO) << "Unsupported data set packing method: "
+                           << int(ptr[size]);
+}
+
+} /* namespace galera */
@@ -9,6 +9,8 @@
 #include "gu_rset.hpp"
 #include "gu_vlq.hpp"
 
+#include <vector>
+
 
 namespace galera
 {
@@ -19,10 +21,11 @@ namespace galera
         enum Version
         {
             EMPTY = 0,
-            VER1
+            VER1,
+            VER2  /* VER1 + optionally compressed payload, see Pack below */
         };
 
-        static Version const MAX_VERSION = VER1;
+        static Version const MAX_VERSION = VER2;
 
         static Version version (unsigned int ver)
         {
@@ -32,6 +35,23 @@ namespace galera
             gu_throw_error (EINVAL) << "Unrecognized DataSet version: " << ver;
         }
 
+        /*! VER2 payload is followed by a trailer, the last byte of which is
+         *  the packing method:
+         *
+         *  [payload][PACK_NONE]
+         *  [deflated payload][uncompressed size: 4 bytes LE][PACK_ZLIB]
+         *
+         *  Trailer is placed at the end since the decision to compress
+         *  can be made only when all the data has been appended. */
+        enum Pack
+        {
+            PACK_NONE = 0,
+            PACK_ZLIB
+        };
+
+        /*! Default payload size below which compression is skipped */
+        static size_t const DEFAULT_COMPRESS_THRESHOLD = 1 << 16; /* 64K */
+
         /*! Dummy class to instantiate DataSetOut */
         class RecordOut {};
 
@@ -79,32 +99,58 @@ namespace galera
 
         DataSetOut () // empty ctor for slave TrxHandle
             :
-            gu::RecordSetOut<DataSet::RecordOut>(), version_()
+            gu::RecordSetOut<DataSet::RecordOut>(), version_(),
+            base_name_(NULL), threshold_(0), payload_(), zbuf_(), zset_(NULL),
+            gathered_(), gathered_size_(-1)
         {}
 
+        /*! @param threshold VER2 payloads of this size and above are
+         *                   compressed, 0 disables compression */
         DataSetOut (gu::byte_t*             reserved,
                     size_t                  reserved_size,
                     const BaseName&         base_name,
-                    DataSet::Version        version)
+                    DataSet::Version        version,
+                    gu::RecordSet::CheckType ct = gu::RecordSet::CHECK_MMH128,
+                    size_t                  threshold =
+                    DataSet::DEFAULT_COMPRESS_THRESHOLD,
+                    gu::Allocator::PageCache* cache = NULL)
             :
             gu::RecordSetOut<DataSet::RecordOut> (
                 reserved,
                 reserved_size,
                 base_name,
-                check_type      (version),
-                ds_to_rs_version(version)
+                check_type      (version, ct),
+                ds_to_rs_version(version),
+                cache
                 ),
-            version_(version)
+            version_  (version),
+            base_name_(&base_name),
+            threshold_(threshold),
+            payload_  (),
+            zbuf_     (),
+            zset_     (NULL),
+            gathered_ (),
+            gathered_size_(-1)
         {}
 
+        ~DataSetOut() { delete zset_; }
+
         size_t
         append (const void* const src, size_t const size, bool const store)
         {
             /* append data as is, don't count as a new record */
-            gu::RecordSetOut<DataSet::RecordOut>::append (src, size, store,
-                                                          false);
+            std::pair<const gu::byte_t*, size_t> const res(
+                gu::RecordSetOut<DataSet::RecordOut>::append (src, size, store,
+                                                              false));
             /* this will be deserialized using DataSet::RecordIn in DataSetIn */
 
+            if (DataSet::VER2 == version_)
+            {
+                /* remember where the payload is to compress it in gather() */
+                gu::Buf const b = { res.first, ssize_t(res.second) };
+                payload_.push_back(b);
+            }
+
             return size;
         }
 
@@ -113,18 +159,36 @@ namespace galera
 
         typedef gu::RecordSet::GatherVector GatherVector;
 
+        /*! For VER2 finalizes the payload (compressing it if it is big
+         *  enough) and then works as RecordSetOutBase::gather().
+         *  The set is finalized by the first call only, subsequent calls
+         *  return the same buffers. */
+        ssize_t gather (GatherVector& out);
+
     private:
 
         // depending on version we may pack data differently
         DataSet::Version const version_;
 
+        const BaseName*         base_name_;
+        size_t const            threshold_;
+        std::vector<gu::Buf>    payload_; // VER2 appended fragments
+        std::vector<gu::byte_t> zbuf_;    // compressed payload
+        gu::RecordSetOut<DataSet::RecordOut>* zset_; // compressed record set
+        std::vector<gu::Buf>    gathered_;      // result of the first gather()
+        ssize_t                 gathered_size_; // -1 - not gathered yet
+
+        /* returns false if compression failed or was not worth it */
+        bool compress (size_t payload_size);
+
         static gu::RecordSet::CheckType
-        check_type (DataSet::Version ver)
+        check_type (DataSet::Version ver, gu::RecordSet::CheckType ct)
         {
             switch (ver)
             {
             case DataSet::EMPTY: break; /* Can't create EMPTY DataSetOut */
-            case DataSet::VER1:  return gu::RecordSet::CHECK_MMH128;
+            case DataSet::VER1:
+            case DataSet::VER2:  return ct;
             }
             throw;
         }
@@ -135,7 +199,8 @@ namespace galera
             switch (ver)
             {
             case DataSet::EMPTY: break; /* Can't create EMPTY DataSetOut */
-            case DataSet::VER1:  return gu::RecordSet::VER1;
+            case DataSet::VER1:
+            case DataSet::VER2:  return gu::RecordSet::VER1;
             }
             throw;
         }
@@ -149,28 +214,41 @@ namespace galera
         DataSetIn (DataSet::Version ver, const gu::byte_t* buf, size_t size)
             :
             gu::RecordSetIn<DataSet::RecordIn>(buf, size, false),
-            version_(ver)
+            version_(ver),
+            unpacked_()
         {}
 
         DataSetIn () : gu::RecordSetIn<DataSet::RecordIn>(),
-                       version_(DataSet::EMPTY)
+                       version_(DataSet::EMPTY),
+                       unpacked_()
         {}
 
         void init (DataSet::Version ver, const gu::byte_t* buf, size_t size)
         {
             gu::RecordSetIn<DataSet::RecordIn>::init(buf, size, false);
             version_ = ver;
+            unpacked_.clear();
         }
 
         gu::Buf next () const
         {
-            return gu::RecordSetIn<DataSet::RecordIn>::next().buf();
+            gu::Buf const ret(gu::RecordSetIn<DataSet::RecordIn>::next().buf());
+
+            if (DataSet::VER2 == version_) return unpack(ret);
+
+            return ret;
         }
 
     private:
 
         DataSet::Version version_;
 
+        /* decompressed payload, filled on first access */
+        mutable std::vector<gu::byte_t> unpacked_;
+
+        /* strips VER2 trailer and decompresses payload if needed */
+        gu::Buf unpack (const gu::Buf& rec) const;
+
     }; /* class DataSetIn */
 
 #if defined(__GNUG__)
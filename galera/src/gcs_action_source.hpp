@@ -12,7 +12,7 @@
 
 #include "GCache.hpp"
 
-#include "gu_atomic.hpp"
+#include "gu_sharded_counter.hpp"
 
 namespace galera
 {
@@ -50,8 +50,8 @@ namespace galera
         GCS_IMPL&             gcs_;
         Replicator&           replicator_;
         gcache::GCache&       gcache_;
-        gu::Atomic<long long> received_;
-        gu::Atomic<long long> received_bytes_;
+        gu::ShardedCounter    received_;
+        gu::ShardedCounter    received_bytes_;
     };
 
     class GcsActionTrx
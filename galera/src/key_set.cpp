@@ -395,6 +395,30 @@ out:
     return size() - old_size;
 }
 
+size_t
+KeySetOut::append (int                const proto_ver,
+                   const wsrep_key_t* const keys,
+                   size_t             const keys_num,
+                   wsrep_key_type_t   const type,
+                   bool               const copy)
+{
+    size_t parts_num(0);
+    for (size_t i(0); i < keys_num; ++i) parts_num += keys[i].key_parts_num;
+
+    added_.reserve(parts_num);
+
+    size_t const old_size(size());
+
+    for (size_t i(0); i < keys_num; ++i)
+    {
+        KeyData const kd(proto_ver, keys[i].key_parts, keys[i].key_parts_num,
+                         type, copy);
+        append(kd);
+    }
+
+    return size() - old_size;
+}
+
 #if 0
 const KeyIn&
 galera::KeySetIn::get_key() const
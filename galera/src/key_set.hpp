@@ -489,7 +489,22 @@ public:
             return end();
         }
 
-        size_t size() const { return (first_size_ + second_->size()); }
+        size_t size() const
+        {
+            return (first_size_ + (second_ ? second_->size() : 0));
+        }
+
+        /* prepares for insertion of n more key parts: if they are not
+         * likely to fit in preallocated buckets, sizes heap-based set
+         * upfront to avoid repeated rehashing */
+        void reserve(size_t const n)
+        {
+            if (first_size_ + n <= FIRST_SIZE / 2) return;
+
+            if (!second_) second_ = new KeyPartSet();
+
+            second_->rehash(second_->size() + n);
+        }
 
     private:
 
@@ -621,14 +636,17 @@ public:
     KeySetOut (gu::byte_t*             reserved,
                size_t                  reserved_size,
                const BaseName&         base_name,
-               KeySet::Version const   version)
+               KeySet::Version const   version,
+               gu::RecordSet::CheckType const ct = gu::RecordSet::CHECK_MMH128,
+               gu::Allocator::PageCache* const cache = NULL)
         :
         gu::RecordSetOut<KeySet::KeyPart> (
             reserved,
             reserved_size,
             base_name,
-            check_type      (version),
-            ks_to_rs_version(version)
+            check_type      (version, ct),
+            ks_to_rs_version(version),
+            cache
             ),
         added_(),
         prev_ (),
@@ -645,6 +663,17 @@ public:
     size_t
     append (const KeyData& kd);
 
+    /*! Appends a batch of keys of the same type. Equivalent to appending
+     *  them one by one, but sizes the key part set once for the whole batch.
+     *  Subsequent keys reuse hash state of common prefix with the previous
+     *  key, so batches of keys sorted by prefix are cheapest. */
+    size_t
+    append (int                proto_ver,
+            const wsrep_key_t* keys,
+            size_t             keys_num,
+            wsrep_key_type_t   type,
+            bool               copy);
+
     KeySet::Version
     version () { return count() ? version_ : KeySet::EMPTY; }
 
@@ -657,12 +686,12 @@ private:
     KeySet::Version       version_;
 
     static gu::RecordSet::CheckType
-    check_type (KeySet::Version ver)
+    check_type (KeySet::Version ver, gu::RecordSet::CheckType ct)
     {
         switch (ver)
         {
         case KeySet::EMPTY: break; /* Can't create EMPTY KeySetOut */
-        default: return gu::RecordSet::CHECK_MMH128;
+        default: return ct;
         }
 
         KeySet::throw_version(ver);
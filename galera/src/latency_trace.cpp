@@ -0,0 +1,58 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+#include "latency_trace.hpp"
+
+#include <gu_time.h>
+
+#include <sstream>
+
+galera::LatencyTrace::LatencyTrace() : hist_(), enabled_(false) {}
+
+long long
+galera::LatencyTrace::now()
+{
+    return gu_time_monotonic();
+}
+
+void
+galera::LatencyTrace::get_status(gu::Status& status) const
+{
+    for (int s(0); s < STAGE_MAX; ++s)
+    {
+        gu::LogHistogram::Snapshot snap;
+        hist_[s].snapshot(snap);
+
+        std::ostringstream os;
+        snap.print_percentiles(os, 1000);
+        os << '/' << snap.count();
+
+        status.insert(std::string("repl_latency_") + stage_name(Stage(s)),
+                      os.str());
+    }
+}
+
+void
+galera::LatencyTrace::reset()
+{
+    for (int s(0); s < STAGE_MAX; ++s) hist_[s].clear();
+}
+
+const char*
+galera::LatencyTrace::stage_name(Stage const s)
+{
+    switch (s)
+    {
+    case REPLICATE:      return "replicate";
+    case LOCAL_MONITOR:  return "local_monitor";
+    case CERTIFY:        return "certify";
+    case APPLY_MONITOR:  return "apply_monitor";
+    case COMMIT_MONITOR: return "commit_monitor";
+    case COMMIT:         return "commit";
+    case TOTAL:          return "total";
+    case STAGE_MAX:      break;
+    }
+
+    return "unknown";
+}
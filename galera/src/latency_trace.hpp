@@ -0,0 +1,123 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+/*
+ * Optional breakdown of local transaction commit latency by stage.
+ *
+ * Each local TrxHandle carries a pair of timestamps. When tracing is enabled
+ * replicate() starts the trace and every following stage records the time
+ * elapsed since the previous one into a per-stage histogram. Transactions
+ * which started replicating while tracing was disabled are not traced, so
+ * the cost of disabled tracing is a single flag check per stage.
+ *
+ * Latencies are recorded in lock-free log-linear histograms
+ * (gu::LogHistogram).
+ */
+
+#ifndef GALERA_LATENCY_TRACE_HPP
+#define GALERA_LATENCY_TRACE_HPP
+
+#include <gu_histogram.hpp>
+#include <gu_atomic.hpp>
+#include <gu_macros.h>
+#include <gu_status.hpp>
+
+#include <cassert>
+
+namespace galera
+{
+    class LatencyTrace
+    {
+    public:
+
+        enum Stage
+        {
+            REPLICATE,      // send monitor wait and total ordering in GCS
+            LOCAL_MONITOR,  // waiting for preceding trxs to certify
+            CERTIFY,        // certification and checksum verification
+            APPLY_MONITOR,  // waiting for dependencies to be applied
+            COMMIT_MONITOR, // waiting for preceding trxs to commit
+            COMMIT,         // commit in the DBMS till post_commit()
+            TOTAL,          // replicate() to post_commit()
+            STAGE_MAX
+        };
+
+        /*! Timestamps carried by a transaction, 0 - not traced */
+        struct Times
+        {
+            Times() : start_(0), last_(0) {}
+
+            long long start_;
+            long long last_;
+        };
+
+        LatencyTrace();
+
+        bool enabled() const { return enabled_() != 0; }
+
+        /*! can be changed at runtime while transactions are replicated */
+        void set_enabled(bool val) { enabled_ = val; }
+
+        /*! starts tracing trx if enabled */
+        void start(Times& t) const
+        {
+            if (gu_likely(!enabled_())) { t.last_ = 0; return; }
+
+            t.start_ = t.last_ = now();
+        }
+
+        /*! marks the end of stage s for a traced trx */
+        void mark(Stage s, Times& t)
+        {
+            if (gu_likely(0 == t.last_)) return;
+
+            long long const ts(now());
+            record(s, ts - t.last_);
+            t.last_ = ts;
+        }
+
+        /*! marks the end of the last stage and records total time */
+        void finish(Stage s, Times& t)
+        {
+            if (gu_likely(0 == t.last_)) return;
+
+            mark(s, t);
+            record(TOTAL, t.last_ - t.start_);
+            t.last_ = 0;
+        }
+
+        void record(Stage s, long long nsec)
+        {
+            assert(s < STAGE_MAX);
+            hist_[s].insert(nsec);
+        }
+
+        /*! snapshot of latencies (nsec) recorded for stage */
+        void snapshot(Stage s, gu::LogHistogram::Snapshot& snap) const
+        {
+            assert(s < STAGE_MAX);
+            hist_[s].snapshot(snap);
+        }
+
+        /*! adds "repl_latency_<stage>" variables in the form of
+         *  "p50/p99/p999/count" with latencies in microseconds */
+        void get_status(gu::Status& status) const;
+
+        void reset();
+
+        static const char* stage_name(Stage s);
+
+    private:
+
+        static long long now();
+
+        gu::LogHistogram      hist_[STAGE_MAX];
+        gu::Atomic<int>       enabled_;
+
+        LatencyTrace(const LatencyTrace&);
+        LatencyTrace& operator=(const LatencyTrace&);
+    };
+}
+
+#endif /* GALERA_LATENCY_TRACE_HPP */
@@ -63,7 +63,9 @@ namespace galera
             entered_(0),
             oooe_(0),
             oool_(0),
-            win_size_(0)
+            win_size_(0),
+            left_cb_(0),
+            left_ctx_(0)
         { }
 
         ~Monitor()
@@ -81,6 +83,17 @@ namespace galera
             }
         }
 
+        /*! Callback invoked with monitor mutex held every time last left
+         *  seqno changes. Must not call back into the monitor. */
+        typedef void (*LeftCb)(void* ctx, wsrep_seqno_t last_left);
+
+        void set_left_cb(LeftCb cb, void* ctx)
+        {
+            gu::Lock lock(mutex_);
+            left_cb_  = cb;
+            left_ctx_ = ctx;
+        }
+
         void set_initial_position(wsrep_seqno_t seqno)
         {
             gu::Lock lock(mutex_);
@@ -88,6 +101,7 @@ namespace galera
             {
                 // first call or reset
                 last_entered_ = last_left_ = seqno;
+                notify_left();
             }
             else
             {
@@ -355,6 +369,13 @@ namespace galera
                 }
             }
             assert(last_left_ <= last_entered_);
+
+            notify_left();
+        }
+
+        void notify_left()
+        {
+            if (left_cb_) left_cb_(left_ctx_, last_left_);
         }
 
         void wake_up_next()
@@ -452,6 +473,8 @@ namespace galera
         long oooe_;     // out of order entered
         long oool_;     // out of order left
         long win_size_; // window between last_left_ and last_entered_
+        LeftCb left_cb_;
+        void*  left_ctx_;
     };
 }
 
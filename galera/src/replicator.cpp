@@ -4,10 +4,16 @@
 
 #include "replicator.hpp"
 
+#include "gu_profile.hpp"
+
 namespace galera
 {
 
 std::string const Replicator::Param::debug_log = "debug";
+std::string const Replicator::Param::log_async = "log_async";
+std::string const Replicator::Param::profile = "profile";
+std::string const Replicator::Param::profile_dump = "profile_dump";
+std::string const Replicator::Param::profile_ring_size = "profile_ring_size";
 #ifdef GU_DBUG_ON
 std::string const Replicator::Param::dbug = "dbug";
 std::string const Replicator::Param::signal = "signal";
@@ -16,6 +22,11 @@ std::string const Replicator::Param::signal = "signal";
 void Replicator::register_params(gu::Config& conf)
 {
     conf.add(Param::debug_log, "no");
+    conf.add(Param::log_async, "no");
+    conf.add(Param::profile, "no");
+    conf.add(Param::profile_dump, "");
+    conf.add(Param::profile_ring_size,
+             gu::to_string(gu::prof::Trace::DEFAULT_RING_SIZE));
 #ifdef GU_DBUG_ON
     conf.add(Param::dbug, "");
     conf.add(Param::signal, "");
@@ -28,6 +28,10 @@ namespace galera
         struct Param
         {
             static std::string const debug_log;
+            static std::string const log_async;
+            static std::string const profile;
+            static std::string const profile_dump;
+            static std::string const profile_ring_size;
 #ifdef GU_DBUG_ON
             static std::string const dbug;
             static std::string const signal;
@@ -11,6 +11,7 @@
 
 #include <gu_debug_sync.hpp>
 #include <gu_abort.h>
+#include <gu_log_async.hpp>
 
 #include <sstream>
 #include <iostream>
@@ -147,7 +148,11 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
     trx_params_         (config_.get(BASE_DIR), -1,
                          KeySet::version(config_.get(Param::key_format)),
                          gu::from_string<int>(config_.get(
-                             Param::max_write_set_size))),
+                             Param::max_write_set_size)),
+                         WriteSetNG::DEFAULT_CHECK,
+                         DataSet::VER1, // until protocol version is known
+                         gu::from_string<size_t>(config_.get(
+                             Param::compress_threshold))),
     uuid_               (WSREP_UUID_UNDEFINED),
     state_uuid_         (WSREP_UUID_UNDEFINED),
     state_uuid_str_     (),
@@ -178,6 +183,7 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
     service_thd_        (gcs_, gcache_),
     slave_pool_         (sizeof(TrxHandle), 1024, "SlaveTrxHandle"),
     as_                 (0),
+    sched_              (),
     gcs_as_             (slave_pool_, gcs_, *this, gcache_),
     ist_receiver_       (config_, slave_pool_, args->node_address),
     ist_prepared_       (false),
@@ -197,6 +203,7 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
     commit_monitor_     (),
 #endif /* HAVE_PSI_INTERFACE */
     causal_read_timeout_(config_.get(Param::causal_read_timeout)),
+    trace_              (),
     receivers_          (),
     replicated_         (),
     replicated_bytes_   (),
@@ -289,6 +296,12 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
 
     cc_seqno_ = seqno; // is it needed here?
 
+    sched_.set_enabled(config_.get<bool>(Param::apply_schedule));
+    if (sched_.enabled())
+    {
+        apply_monitor_.set_left_cb(ApplyScheduler::left_cb, &sched_);
+    }
+
     // the following initialization is needed only to pass seqno to
     // connect() call. Ideally this should be done only on receving conf change.
     apply_monitor_.set_initial_position(seqno);
@@ -296,6 +309,15 @@ galera::ReplicatorSMM::ReplicatorSMM(const struct wsrep_init_args* args)
         commit_monitor_.set_initial_position(seqno);
     cert_.assign_initial_position(seqno, trx_proto_ver());
 
+    ChecksumPool::instance().set_max_threads(
+        gu::from_string<int>(config_.get(Param::checksum_threads)));
+
+    wsdb_.set_page_cache_limits(
+        gu::from_string<size_t>(config_.get(Param::ws_page_cache_size)),
+        gu::from_string<int>(config_.get(Param::ws_page_cache_files)));
+
+    trace_.set_enabled(config_.get<bool>(Param::latency_trace));
+
     build_stats_vars(wsrep_stats_);
 }
 
@@ -318,6 +340,9 @@ galera::ReplicatorSMM::~ReplicatorSMM()
     case S_DESTROYED:
         break;
     }
+
+    // writer thread must not outlive the provider library
+    gu::AsyncLog::stop();
 }
 
 
@@ -403,35 +428,59 @@ wsrep_status_t galera::ReplicatorSMM::async_recv(void* recv_ctx)
     as_ = &gcs_as_;
 
     bool exit_loop(false);
+    bool exit_pending(false); // exit requested while write-sets were parked
     wsrep_status_t retval(WSREP_OK);
 
     while (WSREP_OK == retval && state_() != S_CLOSING)
     {
         ssize_t rc;
 
-        while (gu_unlikely((rc = as_->process(recv_ctx, exit_loop))
-                           == -ECANCELED))
+        // parked write-sets which became ready go before new actions
+        TrxHandle* const parked(sched_.enabled() ? sched_.next() : 0);
+
+        if (parked != 0)
         {
-            recv_IST(recv_ctx);
-            // hack: prevent fast looping until ist controlling thread
-            // resumes gcs prosessing
-            usleep(10000);
+            gu_trace(apply_parked_trx(recv_ctx, parked, exit_loop));
+            rc = 1;
+        }
+        else
+        {
+            while (gu_unlikely((rc = as_->process(recv_ctx, exit_loop))
+                               == -ECANCELED))
+            {
+                recv_IST(recv_ctx);
+                // hack: prevent fast looping until ist controlling thread
+                // resumes gcs prosessing
+                usleep(10000);
+            }
         }
 
         if (gu_unlikely(rc <= 0))
         {
             retval = WSREP_CONN_FAIL;
         }
-        else if (gu_unlikely(exit_loop == true))
+        else if (gu_unlikely(exit_loop == true || exit_pending == true))
         {
             assert(WSREP_OK == retval);
 
+            // a thread may be needed to apply parked write-sets, remember
+            // the request since the next action will overwrite exit_loop
+            if (sched_.parked() > 0)
+            {
+                exit_pending = true;
+                continue;
+            }
+
+            exit_pending = false;
+
             if (receivers_.sub_and_fetch(1) > 0)
             {
                 log_info << "Slave thread exiting on request.";
+                exit_loop = true;
                 break;
             }
 
+            exit_loop = false;
             ++receivers_;
             log_warn << "Refusing exit for the last slave thread.";
         }
@@ -585,6 +634,8 @@ wsrep_status_t galera::ReplicatorSMM::replicate(TrxHandle* trx,
 
     trx->set_state(TrxHandle::S_REPLICATING);
 
+    trace_.start(trx->trace_times());
+
     ssize_t rcode(-1);
 
     do
@@ -656,6 +707,8 @@ wsrep_status_t galera::ReplicatorSMM::replicate(TrxHandle* trx,
     replicated_bytes_ += rcode;
     trx->set_gcs_handle(-1);
 
+    trace_.mark(LatencyTrace::REPLICATE, trx->trace_times());
+
     if (trx->new_version())
     {
         gu_trace(trx->unserialize(static_cast<const gu::byte_t*>(act.buf),
@@ -818,6 +871,8 @@ wsrep_status_t galera::ReplicatorSMM::pre_commit(TrxHandle*        trx,
         else throw;
     }
 
+    trace_.mark(LatencyTrace::APPLY_MONITOR, trx->trace_times());
+
     if (gu_unlikely(interrupted) || trx->state() == TrxHandle::S_MUST_ABORT)
     {
         assert(trx->state() == TrxHandle::S_MUST_ABORT);
@@ -840,6 +895,8 @@ wsrep_status_t galera::ReplicatorSMM::pre_commit(TrxHandle*        trx,
                 else throw;
             }
 
+            trace_.mark(LatencyTrace::COMMIT_MONITOR, trx->trace_times());
+
             if (gu_unlikely(interrupted) ||
                 trx->state() == TrxHandle::S_MUST_ABORT)
             {
@@ -986,6 +1043,8 @@ wsrep_status_t galera::ReplicatorSMM::post_commit(TrxHandle* trx)
     report_last_committed(cert_.set_trx_committed(trx));
     apply_monitor_.leave(ao);
 
+    trace_.finish(LatencyTrace::COMMIT, trx->trace_times());
+
     trx->set_state(TrxHandle::S_COMMITTED);
 
     ++local_commits_;
@@ -1153,8 +1212,9 @@ writeset_from_handle (wsrep_po_handle_t& handle,
                 trx_params.working_dir_, wsrep_trx_id_t(&handle),
                 /* key format is not essential since we're not adding keys */
                 KeySet::version(trx_params.key_format_), NULL, 0,
-                0, WriteSetNG::MAX_VERSION, DataSet::MAX_VERSION, DataSet::MAX_VERSION,
-                trx_params.max_write_set_size_);
+                0, WriteSetNG::MAX_VERSION, trx_params.data_set_ver_,
+                trx_params.data_set_ver_, trx_params.max_write_set_size_,
+                trx_params.record_set_check_, trx_params.compress_threshold_);
 
             handle.opaque = ret;
         }
@@ -1289,19 +1349,11 @@ void galera::ReplicatorSMM::process_trx(void* recv_ctx, TrxHandle* trx)
     switch (retval)
     {
     case WSREP_OK:
-        try
-        {
-            gu_trace(apply_trx(recv_ctx, trx));
-        }
-        catch (std::exception& e)
-        {
-            st_.mark_corrupt();
+        // if dependency is not applied yet, leave trx to the first free
+        // slave thread and go for the next action
+        if (sched_.enabled() && sched_.park(trx)) break;
 
-            log_fatal << "Failed to apply trx: " << *trx;
-            log_fatal << e.what();
-            log_fatal << "Node consistency compromized, aborting...";
-            abort();
-        }
+        gu_trace(apply_slave_trx(recv_ctx, trx));
         break;
     case WSREP_TRX_FAIL:
         // certification failed, apply monitor has been canceled
@@ -1317,6 +1369,36 @@ void galera::ReplicatorSMM::process_trx(void* recv_ctx, TrxHandle* trx)
 }
 
 
+void galera::ReplicatorSMM::apply_slave_trx(void* recv_ctx, TrxHandle* trx)
+{
+    try
+    {
+        gu_trace(apply_trx(recv_ctx, trx));
+    }
+    catch (std::exception& e)
+    {
+        st_.mark_corrupt();
+
+        log_fatal << "Failed to apply trx: " << *trx;
+        log_fatal << e.what();
+        log_fatal << "Node consistency compromized, aborting...";
+        abort();
+    }
+}
+
+
+void galera::ReplicatorSMM::apply_parked_trx(void*      recv_ctx,
+                                             TrxHandle* trx,
+                                             bool&      exit_loop)
+{
+    trx->lock();
+    gu_trace(apply_slave_trx(recv_ctx, trx));
+    exit_loop = trx->exit_loop();
+    trx->unlock();
+    trx->unref(); // reference taken in ApplyScheduler::park()
+}
+
+
 void galera::ReplicatorSMM::process_commit_cut(wsrep_seqno_t seq,
                                                wsrep_seqno_t seqno_l)
 {
@@ -1366,12 +1448,27 @@ void galera::ReplicatorSMM::establish_protocol_versions (int proto_ver)
         trx_params_.version_ = 3;
         str_proto_ver_ = 2;
         break;
+    case 8:
+        // All members understand CRC32C record set checksums.
+        trx_params_.version_ = 3;
+        str_proto_ver_ = 2;
+        break;
+    case 9:
+        // All members understand compressed data sets.
+        trx_params_.version_ = 3;
+        str_proto_ver_ = 2;
+        break;
     default:
         log_fatal << "Configuration change resulted in an unsupported protocol "
             "version: " << proto_ver << ". Can't continue.";
         abort();
     };
 
+    trx_params_.record_set_check_ = proto_ver >= 8 ?
+        WriteSetNG::best_check_type() : WriteSetNG::DEFAULT_CHECK;
+
+    trx_params_.data_set_ver_ = proto_ver >= 9 ? DataSet::VER2 : DataSet::VER1;
+
     protocol_version_ = proto_ver;
     log_info << "REPL Protocols: " << protocol_version_ << " ("
               << trx_params_.version_ << ", " << str_proto_ver_ << ")";
@@ -1808,6 +1905,8 @@ wsrep_status_t galera::ReplicatorSMM::cert(TrxHandle* trx)
         else throw;
     }
 
+    trace_.mark(LatencyTrace::LOCAL_MONITOR, trx->trace_times());
+
     wsrep_status_t retval(WSREP_OK);
     bool const applicable(trx->global_seqno() > STATE_SEQNO());
 
@@ -1897,6 +1996,8 @@ wsrep_status_t galera::ReplicatorSMM::cert(TrxHandle* trx)
         }
     }
 
+    trace_.mark(LatencyTrace::CERTIFY, trx->trace_times());
+
     if (gu_unlikely(WSREP_TRX_FAIL == retval && applicable))
     {
         // applicable but failed certification: self-cancel monitors
@@ -23,8 +23,10 @@
 #include "galera_service_thd.hpp"
 #include "fsm.hpp"
 #include "gcs_action_source.hpp"
+#include "apply_scheduler.hpp"
 #include "ist.hpp"
 #include "gu_atomic.hpp"
+#include "gu_sharded_counter.hpp"
 #include "saved_state.hpp"
 #include "gu_debug_sync.hpp"
 
@@ -177,6 +179,12 @@ namespace galera
             static const std::string commit_order;
             static const std::string causal_read_timeout;
             static const std::string max_write_set_size;
+            static const std::string checksum_threads;
+            static const std::string compress_threshold;
+            static const std::string ws_page_cache_size;
+            static const std::string ws_page_cache_files;
+            static const std::string latency_trace;
+            static const std::string apply_schedule;
         };
 
         typedef std::pair<std::string, std::string> Default;
@@ -206,6 +214,11 @@ namespace galera
 
         wsrep_status_t cert(TrxHandle* trx);
         wsrep_status_t cert_and_catch(TrxHandle* trx);
+
+        /* any exception while applying slave trx is fatal */
+        void apply_slave_trx(void* recv_ctx, TrxHandle* trx);
+        /* applies trx taken from apply scheduler */
+        void apply_parked_trx(void* recv_ctx, TrxHandle* trx, bool& exit_loop);
         wsrep_status_t cert_for_aborted(TrxHandle* trx);
 
         void update_state_uuid (const wsrep_uuid_t& u,
@@ -598,6 +611,7 @@ namespace galera
         // action sources
         TrxHandle::SlavePool slave_pool_;
         ActionSource*        as_;
+        ApplyScheduler       sched_;
         GcsActionSource      gcs_as_;
         ist::Receiver        ist_receiver_;
         bool                 ist_prepared_;
@@ -612,20 +626,21 @@ namespace galera
         Monitor<ApplyOrder>  apply_monitor_;
         Monitor<CommitOrder> commit_monitor_;
         gu::datetime::Period causal_read_timeout_;
+        LatencyTrace         trace_;
 
-        // counters
+        // counters, sharded between threads, summed only in stats_get()
         gu::Atomic<size_t>    receivers_;
-        gu::Atomic<long long> replicated_;
-        gu::Atomic<long long> replicated_bytes_;
-        gu::Atomic<long long> keys_count_;
-        gu::Atomic<long long> keys_bytes_;
-        gu::Atomic<long long> data_bytes_;
-        gu::Atomic<long long> unrd_bytes_;
-        gu::Atomic<long long> local_commits_;
-        gu::Atomic<long long> local_rollbacks_;
-        gu::Atomic<long long> local_cert_failures_;
-        gu::Atomic<long long> local_replays_;
-        gu::Atomic<long long> causal_reads_;
+        gu::ShardedCounter    replicated_;
+        gu::ShardedCounter    replicated_bytes_;
+        gu::ShardedCounter    keys_count_;
+        gu::ShardedCounter    keys_bytes_;
+        gu::ShardedCounter    data_bytes_;
+        gu::ShardedCounter    unrd_bytes_;
+        gu::ShardedCounter    local_commits_;
+        gu::ShardedCounter    local_rollbacks_;
+        gu::ShardedCounter    local_cert_failures_;
+        gu::ShardedCounter    local_replays_;
+        gu::ShardedCounter    causal_reads_;
 
         gu::Atomic<long long> preordered_id_; // temporary preordered ID
 
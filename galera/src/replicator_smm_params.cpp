@@ -6,7 +6,10 @@
 
 #include "gu_uri.hpp"
 #include "write_set_ng.hpp"
+#include "checksum_pool.hpp"
 #include "gu_throw.hpp"
+#include "gu_log_async.hpp"
+#include "gu_profile.hpp"
 
 const std::string galera::ReplicatorSMM::Param::base_host = "base_host";
 const std::string galera::ReplicatorSMM::Param::base_port = "base_port";
@@ -24,8 +27,20 @@ const std::string galera::ReplicatorSMM::Param::key_format =
     common_prefix + "key_format";
 const std::string galera::ReplicatorSMM::Param::max_write_set_size =
     common_prefix + "max_ws_size";
-
-int const galera::ReplicatorSMM::MAX_PROTO_VER(7);
+const std::string galera::ReplicatorSMM::Param::checksum_threads =
+    common_prefix + "checksum_threads";
+const std::string galera::ReplicatorSMM::Param::compress_threshold =
+    common_prefix + "compress_threshold";
+const std::string galera::ReplicatorSMM::Param::ws_page_cache_size =
+    common_prefix + "ws_page_cache_size";
+const std::string galera::ReplicatorSMM::Param::ws_page_cache_files =
+    common_prefix + "ws_page_cache_files";
+const std::string galera::ReplicatorSMM::Param::latency_trace =
+    common_prefix + "latency_trace";
+const std::string galera::ReplicatorSMM::Param::apply_schedule =
+    common_prefix + "apply_schedule";
+
+int const galera::ReplicatorSMM::MAX_PROTO_VER(9);
 
 galera::ReplicatorSMM::Defaults::Defaults() : map_()
 {
@@ -38,6 +53,15 @@ galera::ReplicatorSMM::Defaults::Defaults() : map_()
     const int max_write_set_size(galera::WriteSetNG::MAX_SIZE);
     map_.insert(Default(Param::max_write_set_size,
                         gu::to_string(max_write_set_size)));
+    map_.insert(Default(Param::checksum_threads,
+                        gu::to_string(ChecksumPool::DEFAULT_MAX_THREADS)));
+    map_.insert(Default(Param::compress_threshold,
+                        gu::to_string(DataSet::DEFAULT_COMPRESS_THRESHOLD)));
+    map_.insert(Default(Param::ws_page_cache_size,
+                        gu::to_string(gu::Allocator::DEFAULT_MAX_HEAP)));
+    map_.insert(Default(Param::ws_page_cache_files, "0"));
+    map_.insert(Default(Param::latency_trace, "no"));
+    map_.insert(Default(Param::apply_schedule, "no"));
 }
 
 const galera::ReplicatorSMM::Defaults galera::ReplicatorSMM::defaults;
@@ -137,6 +161,15 @@ galera::ReplicatorSMM::ParseOptions::ParseOptions(Replicator&       repl,
     {
         gu_conf_debug_off();
     }
+
+    if (conf.get<bool>(Replicator::Param::log_async))
+    {
+        gu::AsyncLog::start();
+    }
+
+    gu::prof::Trace::set_ring_size(
+        conf.get<size_t>(Replicator::Param::profile_ring_size));
+    gu::prof::Trace::enable(conf.get<bool>(Replicator::Param::profile));
 #ifdef GU_DBUG_ON
     if (conf.is_set(galera::Replicator::Param::dbug))
     {
@@ -160,7 +193,7 @@ void
 galera::ReplicatorSMM::set_param (const std::string& key,
                                   const std::string& value)
 {
-    if (key == Param::commit_order)
+    if (key == Param::commit_order || key == Param::apply_schedule)
     {
         log_error << "setting '" << key << "' during runtime not allowed";
         gu_throw_error(EPERM)
@@ -186,6 +219,30 @@ galera::ReplicatorSMM::set_param (const std::string& key,
     {
         trx_params_.max_write_set_size_ = gu::from_string<int>(value);
     }
+    else if (key == Param::checksum_threads)
+    {
+        ChecksumPool::instance().set_max_threads(gu::from_string<int>(value));
+    }
+    else if (key == Param::compress_threshold)
+    {
+        trx_params_.compress_threshold_ = gu::from_string<size_t>(value);
+    }
+    else if (key == Param::ws_page_cache_size)
+    {
+        wsdb_.set_page_cache_limits(
+            gu::from_string<size_t>(value),
+            gu::from_string<int>(config_.get(Param::ws_page_cache_files)));
+    }
+    else if (key == Param::ws_page_cache_files)
+    {
+        wsdb_.set_page_cache_limits(
+            gu::from_string<size_t>(config_.get(Param::ws_page_cache_size)),
+            gu::from_string<int>(value));
+    }
+    else if (key == Param::latency_trace)
+    {
+        trace_.set_enabled(gu::Config::from_config<bool>(value));
+    }
     else
     {
         log_warn << "parameter '" << key << "' not found";
@@ -2,6 +2,7 @@
 
 #include "replicator_smm.hpp"
 #include "uuid.hpp"
+#include "checksum_pool.hpp"
 #include <gu_debug_sync.hpp>
 #include <gu_mem.h>
 
@@ -96,12 +97,14 @@ typedef enum status_vars
     STATS_LOCAL_RECV_QUEUE_MAX,
     STATS_LOCAL_RECV_QUEUE_MIN,
     STATS_LOCAL_RECV_QUEUE_AVG,
+    STATS_LOCAL_RECV_QUEUE_BYTES,
     STATS_LOCAL_CACHED_DOWNTO,
     STATS_FC_PAUSED_NS,
     STATS_FC_PAUSED_AVG,
     STATS_FC_SENT,
     STATS_FC_RECEIVED,
     STATS_FC_INTERVAL,
+    STATS_FC_INTERVAL_BYTES,
     STATS_CERT_DEPS_DISTANCE,
     STATS_APPLY_OOOE,
     STATS_APPLY_OOOL,
@@ -115,7 +118,17 @@ typedef enum status_vars
     STATS_CERT_BUCKET_COUNT,
     STATS_GCACHE_POOL_SIZE,
     STATS_CAUSAL_READS,
+    STATS_CAUSAL_READ_MSGS,
     STATS_CERT_INTERVAL,
+    STATS_CHECKSUM_JOBS,
+    STATS_CHECKSUM_THREADS,
+    STATS_CHECKSUM_QUEUE,
+    STATS_CHECKSUM_UTILIZATION,
+    STATS_WS_PAGE_CACHE_HITS,
+    STATS_WS_PAGE_CACHE_MISSES,
+    STATS_WS_PAGE_CACHE_SIZE,
+    STATS_FC_RATE,
+    STATS_FC_PACED_NS,
     STATS_INCOMING_LIST,
     STATS_MAX
 } StatusVars;
@@ -144,12 +157,14 @@ static const struct wsrep_stats_var wsrep_stats[STATS_MAX + 1] =
     { "local_recv_queue_max",     WSREP_VAR_INT64,  { 0 }  },
     { "local_recv_queue_min",     WSREP_VAR_INT64,  { 0 }  },
     { "local_recv_queue_avg",     WSREP_VAR_DOUBLE, { 0 }  },
+    { "local_recv_queue_bytes",   WSREP_VAR_INT64,  { 0 }  },
     { "local_cached_downto",      WSREP_VAR_INT64,  { 0 }  },
     { "flow_control_paused_ns",   WSREP_VAR_INT64,  { 0 }  },
     { "flow_control_paused",      WSREP_VAR_DOUBLE, { 0 }  },
     { "flow_control_sent",        WSREP_VAR_INT64,  { 0 }  },
     { "flow_control_recv",        WSREP_VAR_INT64,  { 0 }  },
     { "flow_control_interval",    WSREP_VAR_STRING, { 0 }  },
+    { "flow_control_interval_bytes", WSREP_VAR_STRING, { 0 }  },
     { "cert_deps_distance",       WSREP_VAR_DOUBLE, { 0 }  },
     { "apply_oooe",               WSREP_VAR_DOUBLE, { 0 }  },
     { "apply_oool",               WSREP_VAR_DOUBLE, { 0 }  },
@@ -163,7 +178,17 @@ static const struct wsrep_stats_var wsrep_stats[STATS_MAX + 1] =
     { "cert_bucket_count",        WSREP_VAR_INT64,  { 0 }  },
     { "gcache_pool_size",         WSREP_VAR_INT64,  { 0 }  },
     { "causal_reads",             WSREP_VAR_INT64,  { 0 }  },
+    { "causal_read_msgs",         WSREP_VAR_INT64,  { 0 }  },
     { "cert_interval",            WSREP_VAR_DOUBLE, { 0 }  },
+    { "checksum_jobs",            WSREP_VAR_INT64,  { 0 }  },
+    { "checksum_threads",         WSREP_VAR_INT64,  { 0 }  },
+    { "checksum_queue",           WSREP_VAR_INT64,  { 0 }  },
+    { "checksum_utilization",     WSREP_VAR_DOUBLE, { 0 }  },
+    { "ws_page_cache_hits",       WSREP_VAR_INT64,  { 0 }  },
+    { "ws_page_cache_misses",     WSREP_VAR_INT64,  { 0 }  },
+    { "ws_page_cache_size",       WSREP_VAR_INT64,  { 0 }  },
+    { "flow_control_rate",        WSREP_VAR_DOUBLE, { 0 }  },
+    { "flow_control_paced_ns",    WSREP_VAR_INT64,  { 0 }  },
     { "incoming_addresses",       WSREP_VAR_STRING, { 0 }  },
     { 0,                          WSREP_VAR_STRING, { 0 }  }
 };
@@ -211,6 +236,10 @@ galera::ReplicatorSMM::stats_get()
     char    interval[64];
     snprintf(interval, sizeof(interval), "[ %ld, %ld ]",
              stats.fc_lower_limit, stats.fc_upper_limit);
+    char    interval_bytes[64];
+    snprintf(interval_bytes, sizeof(interval_bytes), "[ %ld, %ld ]",
+             static_cast<long>(stats.fc_lower_size_limit),
+             static_cast<long>(stats.fc_upper_size_limit));
 
     sv[STATS_LOCAL_SEND_QUEUE    ].value._int64  = stats.send_q_len;
     sv[STATS_LOCAL_SEND_QUEUE_MAX].value._int64  = stats.send_q_len_max;
@@ -220,6 +249,7 @@ galera::ReplicatorSMM::stats_get()
     sv[STATS_LOCAL_RECV_QUEUE_MAX].value._int64  = stats.recv_q_len_max;
     sv[STATS_LOCAL_RECV_QUEUE_MIN].value._int64  = stats.recv_q_len_min;
     sv[STATS_LOCAL_RECV_QUEUE_AVG].value._double = stats.recv_q_len_avg;
+    sv[STATS_LOCAL_RECV_QUEUE_BYTES].value._int64 = stats.recv_q_size;
     sv[STATS_LOCAL_CACHED_DOWNTO ].value._int64  =
         seqno_min != GCS_SEQNO_ILL ? seqno_min : GCS_SEQNO_NIL;
     sv[STATS_FC_PAUSED_NS        ].value._int64  = stats.fc_paused_ns;
@@ -227,6 +257,9 @@ galera::ReplicatorSMM::stats_get()
     sv[STATS_FC_SENT             ].value._int64  = stats.fc_sent;
     sv[STATS_FC_RECEIVED         ].value._int64  = stats.fc_received;
     sv[STATS_FC_INTERVAL         ].value._string = interval;
+    sv[STATS_FC_INTERVAL_BYTES   ].value._string = interval_bytes;
+    sv[STATS_FC_RATE             ].value._double = stats.fc_rate;
+    sv[STATS_FC_PACED_NS         ].value._int64  = stats.fc_paced_ns;
 
 
 
@@ -264,10 +297,28 @@ galera::ReplicatorSMM::stats_get()
     sv[STATS_LOCAL_STATE_COMMENT ].value._string = state2stats_str(state_(),
                                                                    sst_state_);
     sv[STATS_CAUSAL_READS].value._int64    = causal_reads_();
+    sv[STATS_CAUSAL_READ_MSGS].value._int64 = stats.causal_msgs;
+
+    ChecksumPool::Stats cs;
+    ChecksumPool::instance().get_stats(cs);
+
+    sv[STATS_CHECKSUM_JOBS       ].value._int64  = cs.jobs_ + cs.inline_;
+    sv[STATS_CHECKSUM_THREADS    ].value._int64  = cs.threads_;
+    sv[STATS_CHECKSUM_QUEUE      ].value._int64  = cs.queue_;
+    sv[STATS_CHECKSUM_UTILIZATION].value._double = cs.utilization_;
+
+    Wsdb::PageCacheStats ps;
+    wsdb_.get_page_cache_stats(ps);
+
+    sv[STATS_WS_PAGE_CACHE_HITS  ].value._int64  = ps.hits_;
+    sv[STATS_WS_PAGE_CACHE_MISSES].value._int64  = ps.misses_;
+    sv[STATS_WS_PAGE_CACHE_SIZE  ].value._int64  = ps.heap_;
 
     // Get gcs backend status
     gu::Status status;
     gcs_.get_status(status);
+    if (trace_.enabled()) trace_.get_status(status);
+    if (sched_.enabled()) sched_.get_status(status);
 #ifdef GU_DBUG_ON
     status.insert("debug_sync_waiters", gu_debug_sync_waiters());
 #endif // GU_DBUG_ON
@@ -358,6 +409,14 @@ galera::ReplicatorSMM::stats_reset()
     commit_monitor_.flush_stats();
 
     cert_.stats_reset();
+
+    ChecksumPool::instance().flush_stats();
+
+    wsdb_.flush_page_cache_stats();
+
+    trace_.reset();
+
+    sched_.reset();
 }
 
 void
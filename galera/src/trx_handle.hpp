@@ -12,10 +12,12 @@
 #include "key_data.hpp" // for append_key()
 #include "key_entry_os.hpp"
 #include "write_set_ng.hpp"
+#include "latency_trace.hpp"
 
 #include "wsrep_api.h"
 #include "gu_mutex.hpp"
 #include "gu_atomic.hpp"
+#include "gu_sharded_counter.hpp"
 #include "gu_datetime.hpp"
 #include "gu_unordered.hpp"
 #include "gu_utils.hpp"
@@ -48,10 +50,21 @@ namespace galera
             int             version_;
             KeySet::Version key_format_;
             int             max_write_set_size_;
+            gu::RecordSet::CheckType record_set_check_;
+            DataSet::Version data_set_ver_;
+            size_t          compress_threshold_;
             Params (const std::string& wdir, int ver, KeySet::Version kformat,
-                    int max_write_set_size = WriteSetNG::MAX_SIZE) :
+                    int max_write_set_size = WriteSetNG::MAX_SIZE,
+                    gu::RecordSet::CheckType record_set_check =
+                    WriteSetNG::DEFAULT_CHECK,
+                    DataSet::Version data_set_ver = DataSet::MAX_VERSION,
+                    size_t compress_threshold =
+                    DataSet::DEFAULT_COMPRESS_THRESHOLD) :
                 working_dir_(wdir), version_(ver), key_format_(kformat),
-                max_write_set_size_(max_write_set_size) {}
+                max_write_set_size_(max_write_set_size),
+                record_set_check_(record_set_check),
+                data_set_ver_(data_set_ver),
+                compress_threshold_(compress_threshold) {}
         };
 
         static const Params Defaults;
@@ -222,7 +235,8 @@ namespace galera
                               const Params&       params,
                               const wsrep_uuid_t& source_id,
                               wsrep_conn_id_t     conn_id,
-                              wsrep_trx_id_t      trx_id)
+                              wsrep_trx_id_t      trx_id,
+                              gu::Allocator::PageCache* cache = NULL)
         {
             size_t const buf_size(pool.buf_size());
 
@@ -233,7 +247,7 @@ namespace galera
             return new(buf)
                 TrxHandle(pool, params, source_id, conn_id, trx_id,
                           static_cast<gu::byte_t*>(buf) + sizeof(TrxHandle),
-                          buf_size - sizeof(TrxHandle));
+                          buf_size - sizeof(TrxHandle), cache);
         }
 
         void lock()   const { mutex_.lock();   }
@@ -326,6 +340,8 @@ namespace galera
         long gcs_handle() const { return gcs_handle_; }
         void set_gcs_handle(long gcs_handle) { gcs_handle_ = gcs_handle; }
 
+        LatencyTrace::Times& trace_times() { return trace_times_; }
+
         const void* action() const { return action_; }
 
         wsrep_seqno_t local_seqno()     const { return local_seqno_; }
@@ -371,6 +387,37 @@ namespace galera
             }
         }
 
+        void append_keys(int                const proto_ver,
+                         const wsrep_key_t* const keys,
+                         size_t             const keys_num,
+                         wsrep_key_type_t   const type,
+                         bool               const copy)
+        {
+            /*! protection against protocol change during trx lifetime */
+            if (proto_ver != version_)
+            {
+                gu_throw_error(EINVAL) << "key version '" << proto_ver
+                                       << "' does not match to trx version' "
+                                       << version_ << "'";
+            }
+
+            if (new_version())
+            {
+                write_set_out().append_keys(proto_ver, keys, keys_num, type,
+                                            copy);
+            }
+            else
+            {
+                for (size_t i(0); i < keys_num; ++i)
+                {
+                    KeyData const k(proto_ver,
+                                    keys[i].key_parts, keys[i].key_parts_num,
+                                    type, copy);
+                    write_set_.append_key(k);
+                }
+            }
+        }
+
         void append_data(const void* data, const size_t data_len,
                          wsrep_data_type_t type, bool store)
         {
@@ -592,10 +639,10 @@ namespace galera
                 return serial_size();
         }
 
-        void update_stats(gu::Atomic<long long>& kc,
-                          gu::Atomic<long long>& kb,
-                          gu::Atomic<long long>& db,
-                          gu::Atomic<long long>& ub)
+        void update_stats(gu::ShardedCounter& kc,
+                          gu::ShardedCounter& kb,
+                          gu::ShardedCounter& db,
+                          gu::ShardedCounter& ub)
         {
             assert(new_version());
             kc += write_set_in_.keyset().count();
@@ -659,6 +706,7 @@ namespace galera
             mem_pool_          (mp),
             action_            (0),
             gcs_handle_        (-1),
+            trace_times_       (),
             version_           (Defaults.version_),
             refcnt_            (1),
             write_set_flags_   (0),
@@ -677,7 +725,8 @@ namespace galera
                   wsrep_conn_id_t     conn_id,
                   wsrep_trx_id_t      trx_id,
                   gu::byte_t*         reserved,
-                  size_t              reserved_size)
+                  size_t              reserved_size,
+                  gu::Allocator::PageCache* cache)
             :
             source_id_         (source_id),
             conn_id_           (conn_id),
@@ -702,6 +751,7 @@ namespace galera
             mem_pool_          (mp),
             action_            (0),
             gcs_handle_        (-1),
+            trace_times_       (),
             version_           (params.version_),
             refcnt_            (1),
             write_set_flags_   (0),
@@ -712,7 +762,7 @@ namespace galera
             wso_               (new_version()),
             mac_               ()
         {
-            init_write_set_out(params, reserved, reserved_size);
+            init_write_set_out(params, reserved, reserved_size, cache);
         }
 
         ~TrxHandle() { if (wso_) release_write_set_out(); }
@@ -720,7 +770,8 @@ namespace galera
         void
         init_write_set_out(const Params& params,
                            gu::byte_t*   store,
-                           size_t        store_size)
+                           size_t        store_size,
+                           gu::Allocator::PageCache* cache)
         {
             if (wso_)
             {
@@ -736,9 +787,12 @@ namespace galera
                                        store_size - sizeof(WriteSetOut),
                                        0,
                                        WriteSetNG::MAX_VERSION,
-                                       DataSet::MAX_VERSION,
-                                       DataSet::MAX_VERSION,
-                                       params.max_write_set_size_);
+                                       params.data_set_ver_,
+                                       params.data_set_ver_,
+                                       params.max_write_set_size_,
+                                       params.record_set_check_,
+                                       params.compress_threshold_,
+                                       cache);
             }
         }
 
@@ -771,6 +825,7 @@ namespace galera
         gu::MemPool<true>&     mem_pool_;
         const void*            action_;
         long                   gcs_handle_;
+        LatencyTrace::Times    trace_times_;
         int                    version_;
         gu::Atomic<int>        refcnt_;
         uint32_t               write_set_flags_;
@@ -6,6 +6,7 @@
 #include "write_set_ng.hpp"
 
 #include "gu_time.h"
+#include "gu_crc32c.h"
 
 #include <gu_macros.hpp>
 
@@ -48,6 +49,15 @@ WriteSetNG::Header::V3 (
     V3_CRC_OFF
     );
 
+gu::RecordSet::CheckType
+WriteSetNG::best_check_type()
+{
+    /* CRC32C with SSE4.2 instruction is several times faster than MMH3,
+     * software CRC32C is not */
+    return gu_crc32c_hardware() ? gu::RecordSet::CHECK_CRC32C : DEFAULT_CHECK;
+}
+
+
 size_t
 WriteSetNG::Header::gather (KeySet::Version const  kver,
                             DataSet::Version const dver,
@@ -207,20 +217,25 @@ WriteSetIn::init (ssize_t const st)
     {
         if (size_ >= st)
         {
-            /* buffer too big, start checksumming in background */
-            int const err(gu_thread_create (&check_thr_id_, NULL,
-                                            checksum_thread, this));
-
-            if (gu_likely(0 == err))
+            /* buffer too big, checksum record sets in background */
+            try
             {
-                check_thr_ = true;
+                init_sets();
+                checksum_submit();
                 return;
             }
+            catch (std::exception& e)
+            {
+                log_error << e.what();
+            }
+            catch (...)
+            {
+                log_error << "Non-standard exception in WriteSet::init()";
+            }
 
-            log_warn << "Starting checksum thread failed: " << err
-                     << '(' << ::strerror(err) << ')';
-
-            /* fall through to checksum in foreground */
+            /* record set headers are corrupt */
+            assert(!check_thr_);
+            checksum_fin(); // throws
         }
 
         checksum();
@@ -234,59 +249,67 @@ WriteSetIn::init (ssize_t const st)
 
 
 void
-WriteSetIn::checksum()
+WriteSetIn::init_sets()
 {
     const gu::byte_t* pptr (header_.payload());
     ssize_t           psize(size_ - header_.size());
 
     assert (psize >= 0);
 
-    try
+    if (keys_.size() > 0)
     {
-        if (keys_.size() > 0)
-        {
-            gu_trace(keys_.checksum());
-            psize -= keys_.size();
-            assert (psize >= 0);
-            pptr  += keys_.size();
-        }
+        psize -= keys_.size();
+        assert (psize >= 0);
+        pptr  += keys_.size();
+    }
 
-        DataSet::Version const dver(header_.dataset_ver());
+    DataSet::Version const dver(header_.dataset_ver());
 
-        if (gu_likely(dver != DataSet::EMPTY))
+    if (gu_likely(dver != DataSet::EMPTY))
+    {
+        assert (psize > 0);
+        gu_trace(data_.init(dver, pptr, psize));
+        size_t tmpsize(data_.size());
+        psize -= tmpsize;
+        pptr  += tmpsize;
+        assert (psize >= 0);
+
+        if (header_.has_unrd())
         {
-            assert (psize > 0);
-            gu_trace(data_.init(dver, pptr, psize));
-            gu_trace(data_.checksum());
-            size_t tmpsize(data_.size());
+            gu_trace(unrd_.init(dver, pptr, psize));
+            size_t tmpsize(unrd_.size());
             psize -= tmpsize;
             pptr  += tmpsize;
-            assert (psize >= 0);
-
-            if (header_.has_unrd())
-            {
-                gu_trace(unrd_.init(dver, pptr, psize));
-                gu_trace(unrd_.checksum());
-                size_t tmpsize(unrd_.size());
-                psize -= tmpsize;
-                pptr  += tmpsize;
-            }
+        }
 
-            if (header_.has_annt())
-            {
-                annt_ = new DataSetIn();
-                gu_trace(annt_->init(dver, pptr, psize));
-                // we don't care for annotation checksum - it is not a reason
-                // to throw an exception and abort execution
-                // gu_trace(annt_->checksum());
+        if (header_.has_annt())
+        {
+            annt_ = new DataSetIn();
+            gu_trace(annt_->init(dver, pptr, psize));
 #ifndef NDEBUG
-                psize -= annt_->size();
+            psize -= annt_->size();
 #endif
-            }
         }
+    }
 #ifndef NDEBUG
-        assert (psize == 0);
+    assert (psize == 0);
 #endif
+}
+
+
+void
+WriteSetIn::checksum()
+{
+    try
+    {
+        gu_trace(init_sets());
+
+        if (keys_.size() > 0) gu_trace(keys_.checksum());
+        if (data_.size() > 0) gu_trace(data_.checksum());
+        if (unrd_.size() > 0) gu_trace(unrd_.checksum());
+        // we don't care for annotation checksum - it is not a reason
+        // to throw an exception and abort execution
+
         check_ = true;
     }
     catch (std::exception& e)
@@ -300,6 +323,58 @@ WriteSetIn::checksum()
 }
 
 
+void
+WriteSetIn::checksum_submit()
+{
+    ChecksumPool& pool(ChecksumPool::instance());
+
+    check_thr_ = true;
+
+    /* record sets have independent checksums, so each one can be verified
+     * by a separate worker. Data set is the biggest one, submit it first. */
+    if (data_.size() > 0)
+    {
+        check_jobs_[CHECK_DATA].set(data_);
+        pool.submit(check_jobs_[CHECK_DATA], check_handle_);
+    }
+
+    if (keys_.size() > 0)
+    {
+        check_jobs_[CHECK_KEYS].set(keys_);
+        pool.submit(check_jobs_[CHECK_KEYS], check_handle_);
+    }
+
+    if (unrd_.size() > 0)
+    {
+        check_jobs_[CHECK_UNRD].set(unrd_);
+        pool.submit(check_jobs_[CHECK_UNRD], check_handle_);
+    }
+}
+
+
+bool
+WriteSetIn::CheckJob::run()
+{
+    assert(set_);
+
+    try
+    {
+        set_->checksum();
+        return true;
+    }
+    catch (std::exception& e)
+    {
+        log_error << e.what();
+    }
+    catch (...)
+    {
+        log_error << "Non-standard exception in WriteSet::checksum()";
+    }
+
+    return false;
+}
+
+
 void
 WriteSetIn::write_annotation(std::ostream& os) const
 {
@@ -17,6 +17,7 @@
 #include "wsrep_api.h"
 #include "key_set.hpp"
 #include "data_set.hpp"
+#include "checksum_pool.hpp"
 
 #include "gu_serialize.hpp"
 #include "gu_vector.hpp"
@@ -25,8 +26,6 @@
 #include <string>
 #include <iomanip>
 
-#include <pthread.h>
-
 namespace galera
 {
     class WriteSetNG
@@ -43,6 +42,14 @@ namespace galera
         /* Max header version that we can understand */
         static Version const MAX_VERSION = VER3;
 
+        /* Record set checksum understood by all VER3 peers. */
+        static gu::RecordSet::CheckType const DEFAULT_CHECK =
+            gu::RecordSet::CHECK_MMH128;
+
+        /* Best record set checksum for this CPU, requires peers supporting
+         * replication protocol 8 or above */
+        static gu::RecordSet::CheckType best_check_type();
+
         /* Parses beginning of the header to detect writeset version and
          * returns it as raw integer for backward compatibility
          * static Version version(int v) will convert it to enum */
@@ -365,7 +372,7 @@ namespace galera
                   bits 0-3: minimum compatible version
                2: header size (payload offset)
                3: bits 4-7: keyset  version
-                  bits 2-3: dataset version
+                  bits 2-3: dataset version (VER2 may be compressed)
                   bit 1:    has unordered set
                   bit 0:    has annotation
                4-5: flags
@@ -494,7 +501,11 @@ namespace galera
                      WriteSetNG::Version     ver      = WriteSetNG::MAX_VERSION,
                      DataSet::Version        dver     = DataSet::MAX_VERSION,
                      DataSet::Version        uver     = DataSet::MAX_VERSION,
-                     size_t                  max_size = WriteSetNG::MAX_SIZE)
+                     size_t                  max_size = WriteSetNG::MAX_SIZE,
+                     gu::RecordSet::CheckType ct   = WriteSetNG::DEFAULT_CHECK,
+                     size_t                  cthresh  =
+                     DataSet::DEFAULT_COMPRESS_THRESHOLD,
+                     gu::Allocator::PageCache* cache  = NULL)
             :
             header_(ver),
             base_name_(dir_name, id),
@@ -502,19 +513,24 @@ namespace galera
             kbn_   (base_name_),
             keys_  (reserved,
                     (reserved_size >>= 6, reserved_size <<= 3, reserved_size),
-                    kbn_, kver),
+                    kbn_, kver, ct, cache),
             /* 5/8 of reserved goes to data set  */
             dbn_   (base_name_),
-            data_  (reserved + reserved_size, reserved_size*5, dbn_, dver),
+            data_  (reserved + reserved_size, reserved_size*5, dbn_, dver, ct,
+                    cthresh, cache),
             /* 2/8 of reserved goes to unordered set  */
             ubn_   (base_name_),
-            unrd_  (reserved + reserved_size*6, reserved_size*2, ubn_, uver),
+            unrd_  (reserved + reserved_size*6, reserved_size*2, ubn_, uver,ct,
+                    cthresh, cache),
             /* annotation set is not allocated unless requested */
             abn_   (base_name_),
             annt_  (NULL),
             left_  (max_size - keys_.size() - data_.size() - unrd_.size()
                     - header_.size()),
-            flags_ (flags)
+            flags_ (flags),
+            check_ (ct),
+            dver_  (dver),
+            cthresh_(cthresh)
         {}
 
         ~WriteSetOut() { delete annt_; }
@@ -524,6 +540,15 @@ namespace galera
             left_ -= keys_.append(k);
         }
 
+        void append_keys(int                const proto_ver,
+                         const wsrep_key_t* const keys,
+                         size_t             const keys_num,
+                         wsrep_key_type_t   const type,
+                         bool               const copy)
+        {
+            left_ -= keys_.append(proto_ver, keys, keys_num, type, copy);
+        }
+
         void append_data(const void* data, size_t data_len, bool store)
         {
             left_ -= data_.append(data, data_len, store);
@@ -538,7 +563,8 @@ namespace galera
         {
             if (NULL == annt_)
             {
-                annt_ = new DataSetOut(NULL, 0, abn_, DataSet::MAX_VERSION);
+                /* all data sets share version in the header */
+                annt_ = new DataSetOut(NULL, 0, abn_, dver_, check_, cthresh_);
                 left_ -= annt_->size();
             }
 
@@ -655,6 +681,9 @@ namespace galera
         DataSetOut*         annt_;
         ssize_t             left_;
         uint16_t            flags_;
+        gu::RecordSet::CheckType const check_;
+        DataSet::Version const dver_;
+        size_t const        cthresh_;
 
         void check_size()
         {
@@ -679,7 +708,8 @@ namespace galera
               data_  (),
               unrd_  (),
               annt_  (NULL),
-              check_thr_id_(),
+              check_handle_(),
+              check_jobs_(),
               check_thr_(false),
               check_ (false)
         {
@@ -693,7 +723,8 @@ namespace galera
               data_  (),
               unrd_  (),
               annt_  (NULL),
-              check_thr_id_(),
+              check_handle_(),
+              check_jobs_(),
               check_thr_(false),
               check_ (false)
         {}
@@ -721,8 +752,8 @@ namespace galera
         {
             if (gu_unlikely(check_thr_))
             {
-                /* checksum was performed in a parallel thread */
-                pthread_join (check_thr_id_, NULL);
+                /* checksum was performed in background */
+                check_handle_.wait();
             }
 
             delete annt_;
@@ -757,8 +788,8 @@ namespace galera
         {
             if (gu_unlikely(check_thr_))
             {
-                /* checksum was performed in a parallel thread */
-                pthread_join (check_thr_id_, NULL);
+                /* checksum was performed in background */
+                check_ = check_handle_.wait();
                 check_thr_ = false;
                 checksum_fin();
             }
@@ -798,14 +829,42 @@ namespace galera
         DataSetIn          data_;
         DataSetIn          unrd_;
         DataSetIn*         annt_;
-        pthread_t          check_thr_id_;
+
+        /* background checksum of a single record set */
+        class CheckJob : public ChecksumPool::Job
+        {
+        public:
+
+            CheckJob() : ChecksumPool::Job(), set_(NULL) {}
+
+            void set (const gu::RecordSetInBase& s) { set_ = &s; }
+
+            bool run();
+
+        private:
+
+            const gu::RecordSetInBase* set_;
+
+            CheckJob(const CheckJob&);
+            CheckJob& operator=(const CheckJob&);
+        };
+
+        enum { CHECK_KEYS, CHECK_DATA, CHECK_UNRD, CHECK_MAX };
+
+        ChecksumPool::Handle check_handle_;
+        CheckJob           check_jobs_[CHECK_MAX];
         bool mutable       check_thr_;
-        bool               check_;
+        bool mutable       check_;
 
         static size_t const SIZE_THRESHOLD = 1 << 22; /* 4Mb */
 
+        void init_sets (); /* initializes data, unordered and annotation sets */
+
         void checksum (); /* checksums writeset, stores result in check_ */
 
+        /* submits record set checksums to ChecksumPool */
+        void checksum_submit ();
+
         void checksum_fin() const
         {
             if (gu_unlikely(!check_))
@@ -814,27 +873,6 @@ namespace galera
             }
         }
 
-        static void* checksum_thread (void* arg)
-        {
-#ifdef HAVE_PSI_INTERFACE
-            pfs_instr_callback(WSREP_PFS_INSTR_TYPE_THREAD,
-                               WSREP_PFS_INSTR_OPS_INIT,
-                               WSREP_PFS_INSTR_TAG_WRITESET_CHECKSUM_THREAD,
-                               NULL, NULL, NULL);
-#endif /* HAVE_PSI_INTERFACE */
-
-            WriteSetIn* ws(reinterpret_cast<WriteSetIn*>(arg));
-            ws->checksum();
-
-#ifdef HAVE_PSI_INTERFACE
-            pfs_instr_callback(WSREP_PFS_INSTR_TYPE_THREAD,
-                               WSREP_PFS_INSTR_OPS_DESTROY,
-                               WSREP_PFS_INSTR_TAG_WRITESET_CHECKSUM_THREAD,
-                               NULL, NULL, NULL);
-#endif /* HAVE_PSI_INTERFACE */
-            return NULL;
-        }
-
         /* late initialization after default constructor */
         void init (ssize_t size_threshold);
 
@@ -32,6 +32,7 @@ void galera::Wsdb::print(std::ostream& os) const
 
 galera::Wsdb::Wsdb()
     :
+    page_caches_(),
     trx_pool_  (TrxHandle::LOCAL_STORAGE_SIZE(), 512, "LocalTrxHandle"),
     trx_map_     (),
     conn_trx_map_(),
@@ -95,12 +96,62 @@ galera::Wsdb::find_trx(wsrep_trx_id_t const trx_id)
 }
 
 
+inline gu::Allocator::PageCache&
+galera::Wsdb::page_cache(size_t h)
+{
+    h ^= (h >> 21) ^ (h >> 13); // thread ids tend to be page aligned
+    return page_caches_[h % PAGE_CACHE_SHARDS];
+}
+
+
+void
+galera::Wsdb::set_page_cache_limits(size_t const max_heap, int const max_files)
+{
+    for (int i(0); i < PAGE_CACHE_SHARDS; ++i)
+    {
+        page_caches_[i].set_limits(max_heap, max_files);
+    }
+}
+
+
+void
+galera::Wsdb::get_page_cache_stats(PageCacheStats& stats) const
+{
+    stats.hits_   = 0;
+    stats.misses_ = 0;
+    stats.heap_   = 0;
+    stats.files_  = 0;
+
+    for (int i(0); i < PAGE_CACHE_SHARDS; ++i)
+    {
+        PageCacheStats s;
+        page_caches_[i].get_stats(s);
+
+        stats.hits_   += s.hits_;
+        stats.misses_ += s.misses_;
+        stats.heap_   += s.heap_;
+        stats.files_  += s.files_;
+    }
+}
+
+
+void
+galera::Wsdb::flush_page_cache_stats()
+{
+    for (int i(0); i < PAGE_CACHE_SHARDS; ++i)
+    {
+        page_caches_[i].flush_stats();
+    }
+}
+
+
 inline galera::TrxHandle*
 galera::Wsdb::create_trx(const TrxHandle::Params& params,
                          const wsrep_uuid_t&  source_id,
                          wsrep_trx_id_t const trx_id)
 {
-    TrxHandle* trx(TrxHandle::New(trx_pool_, params, source_id, -1, trx_id));
+    TrxHandle* trx(TrxHandle::New(trx_pool_, params, source_id, -1, trx_id,
+                                  &page_cache(pthread_self())));
 
     gu::Lock lock(trx_mutex_);
 
@@ -183,7 +234,8 @@ galera::Wsdb::get_conn_query(const TrxHandle::Params& params,
     if (conn->get_trx() == 0 && create == true)
     {
         TrxHandle* trx
-            (TrxHandle::New(trx_pool_, params, source_id, conn_id, -1));
+            (TrxHandle::New(trx_pool_, params, source_id, conn_id, -1,
+                            &page_cache(conn_id)));
         conn->assign_trx(trx);
     }
 
@@ -97,6 +97,13 @@ namespace galera
         void discard_conn(wsrep_conn_id_t conn_id);
         void discard_conn_query(wsrep_conn_id_t conn_id);
 
+        typedef gu::Allocator::PageCache::Stats PageCacheStats;
+
+        /* limits are per cache */
+        void set_page_cache_limits(size_t max_heap, int max_files);
+        void get_page_cache_stats(PageCacheStats& stats) const;
+        void flush_page_cache_stats();
+
         Wsdb();
         ~Wsdb();
 
@@ -113,8 +120,24 @@ namespace galera
 
         Conn*      get_conn(wsrep_conn_id_t conn_id, bool create);
 
+        // Page cache for write set allocators of the connection identified
+        // by key
+        gu::Allocator::PageCache& page_cache(size_t key);
+
         static const size_t trx_mem_limit_ = 1 << 20;
 
+        /* Write set page caches are sharded by connection: by conn_id for
+         * connection queries and by thread for transactions looked up by
+         * trx_id, since wsrep API passes no connection id before
+         * pre_commit() and thread stands for connection there anyway (see
+         * ConnTrxMap). This keeps pages of consecutive transactions of a
+         * connection in the same cache and contention low. Caches are
+         * shared as transactions may outlive their connection.
+         * Must outlive trx_pool_. */
+        static int const PAGE_CACHE_SHARDS = 8;
+
+        gu::Allocator::PageCache page_caches_[PAGE_CACHE_SHARDS];
+
         TrxHandle::LocalPool trx_pool_;
 
         TrxMap       trx_map_;
@@ -5,6 +5,11 @@
 #include "wsrep_params.hpp"
 #include "gu_dbug.h"
 #include "gu_debug_sync.hpp"
+#include "gu_log_async.hpp"
+#include "gu_profile.hpp"
+
+#include <fstream>
+#include <cerrno>
 
 void
 wsrep_set_params (galera::Replicator& repl, const char* params)
@@ -33,6 +38,41 @@ wsrep_set_params (galera::Replicator& repl, const char* params)
                     gu_conf_debug_off();
                 }
             }
+            else if (key == galera::Replicator::Param::profile)
+            {
+                bool const val(gu::from_string<bool>(value));
+                if (val && !gu::prof::Trace::enabled())
+                {
+                    gu::prof::Trace::clear();
+                }
+                gu::prof::Trace::enable(val);
+            }
+            else if (key == galera::Replicator::Param::profile_dump)
+            {
+                std::ofstream os(value.c_str());
+                if (!os)
+                {
+                    gu_throw_error(errno) << "Failed to open '" << value
+                                          << "' for profile dump";
+                }
+                gu::prof::Trace::dump(os);
+                log_info << "Profile trace written to '" << value << "'";
+            }
+            else if (key == galera::Replicator::Param::profile_ring_size)
+            {
+                gu::prof::Trace::set_ring_size(gu::from_string<size_t>(value));
+            }
+            else if (key == galera::Replicator::Param::log_async)
+            {
+                if (gu::from_string<bool>(value))
+                {
+                    gu::AsyncLog::start();
+                }
+                else
+                {
+                    gu::AsyncLog::stop();
+                }
+            }
 #ifdef GU_DBUG_ON
             else if (key == galera::Replicator::Param::dbug)
             {
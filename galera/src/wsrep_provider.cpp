@@ -567,11 +567,16 @@ wsrep_status_t galera_append_key(wsrep_t*           const gh,
     try
     {
         TrxHandleLock lock(*trx);
-        for (size_t i(0); i < keys_num; ++i)
+        if (keys_num > 1)
+        {
+            trx->append_keys(repl->trx_proto_ver(), keys, keys_num,
+                             key_type, copy);
+        }
+        else if (1 == keys_num)
         {
             galera::KeyData k (repl->trx_proto_ver(),
-                               keys[i].key_parts,
-                               keys[i].key_parts_num,
+                               keys[0].key_parts,
+                               keys[0].key_parts_num,
                                key_type,
                                copy);
             trx->append_key(k);
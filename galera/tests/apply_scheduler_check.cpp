@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2016 Codership Oy <info@codership.com>
+ */
+
+#undef NDEBUG
+
+#include "../src/apply_scheduler.hpp"
+
+#include <check.h>
+
+#include <pthread.h>
+#include <unistd.h>
+
+using namespace galera;
+
+static TrxHandle*
+make_trx(TrxHandle::SlavePool& sp, wsrep_seqno_t seqno, wsrep_seqno_t dep)
+{
+    TrxHandle* const trx(TrxHandle::New(sp));
+    trx->set_received(0, seqno, seqno);
+    trx->set_depends_seqno(dep);
+    return trx;
+}
+
+struct NextArg
+{
+    ApplyScheduler* sched;
+    TrxHandle*      trx;
+};
+
+static void* next_thread(void* arg)
+{
+    NextArg* const na(static_cast<NextArg*>(arg));
+    na->trx = na->sched->next();
+    return 0;
+}
+
+START_TEST(apply_scheduler_order)
+{
+    TrxHandle::SlavePool sp(sizeof(TrxHandle), 16, "apply_scheduler_sp");
+    ApplyScheduler sched;
+
+    sched.left(0);
+
+    /* nothing parked - nothing to wait for */
+    fail_if(sched.next() != 0);
+
+    TrxHandle* const t1(make_trx(sp, 1, 0));
+    TrxHandle* const t2(make_trx(sp, 2, 1));
+    TrxHandle* const t3(make_trx(sp, 3, 0));
+    TrxHandle* const t4(make_trx(sp, 4, 2));
+
+    /* ready trxs are not parked */
+    fail_if(sched.park(t1));
+    fail_if(sched.park(t3));
+
+    fail_unless(sched.park(t4));
+    fail_unless(sched.park(t2));
+    fail_if(sched.parked() != 2);
+    fail_if(t2->refcnt() != 2);
+
+    /* the lowest parked trx is not ready, so the first thread waits */
+    NextArg na = { &sched, 0 };
+    pthread_t th;
+    pthread_create(&th, 0, next_thread, &na);
+    usleep(100000);
+    fail_if(na.trx != 0);
+
+    /* ... and the rest go for new actions */
+    fail_if(sched.next() != 0);
+
+    sched.left(1);
+    pthread_join(th, 0);
+    fail_if(na.trx != t2);
+    fail_if(sched.parked() != 1);
+
+    /* t4 is handed out only after its dependency has left */
+    sched.left(2);
+    fail_if(sched.next() != t4);
+    fail_if(sched.parked() != 0);
+    fail_if(sched.next() != 0);
+
+    gu::Status status;
+    sched.get_status(status);
+    fail_if(status.size() != 2);
+
+    t4->unref(); t4->unref();
+    t3->unref();
+    t2->unref(); t2->unref();
+    t1->unref();
+}
+END_TEST
+
+START_TEST(apply_scheduler_lower)
+{
+    TrxHandle::SlavePool sp(sizeof(TrxHandle), 16, "apply_scheduler_sp");
+    ApplyScheduler sched;
+
+    sched.left(5);
+
+    TrxHandle* const t8(make_trx(sp, 8, 7));
+    fail_unless(sched.park(t8));
+
+    NextArg na = { &sched, 0 };
+    pthread_t th;
+    pthread_create(&th, 0, next_thread, &na);
+    usleep(100000);
+    fail_if(na.trx != 0);
+
+    /* trx parked later, but lower and ready, must wake up the waiter */
+    TrxHandle* const t7(make_trx(sp, 7, 6));
+    fail_unless(sched.park(t7));
+    sched.left(6);
+    pthread_join(th, 0);
+    fail_if(na.trx != t7);
+
+    sched.left(7);
+    fail_if(sched.next() != t8);
+
+    t8->unref(); t8->unref();
+    t7->unref(); t7->unref();
+}
+END_TEST
+
+Suite* apply_scheduler_suite()
+{
+    Suite* s = suite_create("ApplyScheduler");
+    TCase* tc;
+
+    tc = tcase_create("apply_scheduler");
+    tcase_add_test(tc, apply_scheduler_order);
+    tcase_add_test(tc, apply_scheduler_lower);
+    suite_add_tcase(s, tc);
+
+    return s;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2016 Codership Oy <info@codership.com>
+ */
+
+#undef NDEBUG
+
+#include "../src/checksum_pool.hpp"
+
+#include <gu_atomic.hpp>
+
+#include <check.h>
+
+#include <unistd.h>
+
+using namespace galera;
+
+namespace
+{
+    class TestJob : public ChecksumPool::Job
+    {
+    public:
+
+        TestJob() : ChecksumPool::Job(), ok_(true), runs_(0) {}
+
+        void set_ok(bool ok) { ok_ = ok; }
+        int  runs() const    { return runs_(); }
+
+        bool run()
+        {
+            usleep(1000);
+            ++runs_;
+            return ok_;
+        }
+
+    private:
+
+        bool                ok_;
+        gu::Atomic<int>     runs_;
+    };
+}
+
+START_TEST(checksum_pool_basic)
+{
+    ChecksumPool pool(2);
+
+    static int const N(16);
+    TestJob jobs[N];
+
+    {
+        ChecksumPool::Handle handle;
+
+        for (int i(0); i < N; ++i) pool.submit(jobs[i], handle);
+
+        fail_unless(handle.wait());
+        fail_if(handle.pending());
+    }
+
+    for (int i(0); i < N; ++i) fail_if(jobs[i].runs() != 1);
+
+    ChecksumPool::Stats stats;
+    pool.get_stats(stats);
+
+    fail_if(stats.jobs_ + stats.inline_ != N);
+    fail_if(stats.threads_ > 2, "threads: %d", stats.threads_);
+    fail_if(stats.threads_ < 1);
+    fail_if(stats.queue_ != 0);
+    fail_if(stats.utilization_ <= 0.0);
+}
+END_TEST
+
+START_TEST(checksum_pool_failure)
+{
+    ChecksumPool pool(3);
+
+    static int const N(8);
+    TestJob jobs[N];
+    jobs[N/2].set_ok(false);
+
+    ChecksumPool::Handle handle;
+
+    for (int i(0); i < N; ++i) pool.submit(jobs[i], handle);
+
+    fail_if(handle.wait());
+}
+END_TEST
+
+START_TEST(checksum_pool_inline)
+{
+    ChecksumPool pool(0);
+
+    TestJob job;
+    ChecksumPool::Handle handle;
+
+    pool.submit(job, handle);
+
+    /* with no workers allowed job must be done in the caller's thread */
+    fail_if(job.runs() != 1);
+    fail_if(handle.pending());
+    fail_unless(handle.wait());
+
+    ChecksumPool::Stats stats;
+    pool.get_stats(stats);
+
+    fail_if(stats.inline_ != 1);
+    fail_if(stats.threads_ != 0);
+
+    /* enable workers and shrink back */
+    pool.set_max_threads(2);
+
+    TestJob job1;
+    pool.submit(job1, handle);
+    fail_unless(handle.wait());
+    fail_if(job1.runs() != 1);
+
+    pool.set_max_threads(0);
+
+    TestJob job2;
+    pool.submit(job2, handle);
+    fail_unless(handle.wait());
+    fail_if(job2.runs() != 1);
+
+    /* repeatedly grow and shrink: exited workers must be reaped */
+    for (int i(0); i < 100; ++i)
+    {
+        pool.set_max_threads(2);
+
+        TestJob job3;
+        pool.submit(job3, handle);
+        fail_unless(handle.wait());
+        fail_if(job3.runs() != 1);
+
+        pool.set_max_threads(0);
+    }
+}
+END_TEST
+
+Suite* checksum_pool_suite()
+{
+    Suite* s = suite_create("ChecksumPool");
+    TCase* tc;
+
+    tc = tcase_create("checksum_pool");
+    tcase_add_test(tc, checksum_pool_basic);
+    tcase_add_test(tc, checksum_pool_failure);
+    tcase_add_test(tc, checksum_pool_inline);
+    suite_add_tcase(s, tc);
+
+    return s;
+}
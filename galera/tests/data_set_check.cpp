@@ -231,10 +231,93 @@ START_TEST (ver0)
 }
 END_TEST
 
+static void
+ver2_test (size_t const threshold, bool const compressed)
+{
+    /* well compressible payload in several fragments */
+    std::vector<gu::byte_t> payload(1 << 18);
+    for (size_t i = 0; i < payload.size(); ++i)
+    {
+        payload[i] = "galera"[(i / 7) % 6];
+    }
+
+    gu::byte_t reserved[1024];
+    TestBaseName str("data_set_test_ver2");
+    DataSetOut dset_out(reserved, sizeof(reserved), str, DataSet::VER2,
+                        gu::RecordSet::CHECK_MMH128, threshold);
+
+    size_t const frag(payload.size() / 4);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        dset_out.append (&payload[i * frag], frag, i % 2);
+    }
+
+    fail_if (DataSet::VER2 != dset_out.version());
+
+    DataSetOut::GatherVector out_bufs;
+    size_t const out_size (dset_out.gather (out_bufs));
+
+    if (compressed)
+    {
+        fail_if (out_size >= payload.size() / 2,
+                 "Payload of %zu compressed only to %zu",
+                 payload.size(), out_size);
+    }
+    else
+    {
+        fail_if (out_size <= payload.size());
+    }
+
+    std::vector<gu::byte_t> in_buf;
+    for (size_t i = 0; i < out_bufs->size(); ++i)
+    {
+        const gu::byte_t* ptr
+            (reinterpret_cast<const gu::byte_t*>(out_bufs[i].ptr));
+        in_buf.insert (in_buf.end(), ptr, ptr + out_bufs[i].size);
+    }
+
+    fail_if (in_buf.size() != out_size);
+
+    /* repeated gather must not finalize the set again */
+    DataSetOut::GatherVector out_bufs2;
+    fail_if (dset_out.gather (out_bufs2) != ssize_t(out_size));
+    fail_if (out_bufs2->size() != out_bufs->size());
+    for (size_t i = 0; i < out_bufs->size(); ++i)
+    {
+        fail_if (out_bufs2[i].ptr  != out_bufs[i].ptr);
+        fail_if (out_bufs2[i].size != out_bufs[i].size);
+    }
+
+    galera::DataSetIn const dset_in(dset_out.version(),
+                                    in_buf.data(), in_buf.size());
+    dset_in.checksum();
+
+    fail_if (dset_in.count() != 1);
+
+    /* second pass must return the same (cached) buffer */
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        dset_in.rewind();
+        gu::Buf data = dset_in.next();
+        fail_if (size_t(data.size) != payload.size(),
+                 "Expected %zu bytes, got %zd", payload.size(), data.size);
+        fail_if (::memcmp(data.ptr, payload.data(), payload.size()));
+    }
+}
+
+START_TEST (ver2)
+{
+    ver2_test (DataSet::DEFAULT_COMPRESS_THRESHOLD, true);
+    ver2_test (1 << 20, false); // below threshold
+    ver2_test (0, false);       // compression disabled
+}
+END_TEST
+
 Suite* data_set_suite ()
 {
     TCase* t = tcase_create ("DataSet");
     tcase_add_test (t, ver0);
+    tcase_add_test (t, ver2);
     tcase_set_timeout(t, 60);
 
     Suite* s = suite_create ("DataSet");
@@ -20,6 +20,9 @@ extern Suite* trx_handle_suite();
 extern Suite* service_thd_suite();
 extern Suite* ist_suite();
 extern Suite* saved_state_suite();
+extern Suite* checksum_pool_suite();
+extern Suite* latency_trace_suite();
+extern Suite* apply_scheduler_suite();
 
 static suite_creator_t suites[] =
 {
@@ -31,6 +34,9 @@ static suite_creator_t suites[] =
     service_thd_suite,
     ist_suite,
     saved_state_suite,
+    checksum_pool_suite,
+    latency_trace_suite,
+    apply_scheduler_suite,
     0
 };
 
@@ -13,6 +13,8 @@
 
 #include <check.h>
 
+#include <sstream>
+
 using namespace galera;
 
 class TestBaseName : public gu::Allocator::BaseName
@@ -237,10 +239,64 @@ START_TEST (ver0)
 }
 END_TEST
 
+START_TEST (batch)
+{
+    KeySet::Version const tk_ver(KeySet::FLAT16A);
+
+    /* enough keys to overflow preallocated buckets */
+    static int const N(200);
+
+    std::vector<std::string>  names(N);
+    std::vector<wsrep_buf_t>  parts(N * 3);
+    std::vector<wsrep_key_t>  keys(N);
+
+    for (int i(0); i < N; ++i)
+    {
+        std::ostringstream os;
+        os << "row" << (i % (N/2 - 10)); // 10 duplicates per table
+        names[i] = os.str();
+
+        wsrep_buf_t* const p(&parts[i * 3]);
+        p[0].ptr = "db";    p[0].len = 3;
+        p[1].ptr = i < N/2 ? "t1" : "t2"; p[1].len = 3;
+        p[2].ptr = names[i].c_str(); p[2].len = names[i].length() + 1;
+
+        keys[i].key_parts     = p;
+        keys[i].key_parts_num = 3;
+    }
+
+    gu::byte_t reserved1[1024];
+    TestBaseName const str1("key_set_test_single");
+    KeySetOut kso1 (reserved1, sizeof(reserved1), str1, tk_ver);
+
+    size_t size1(0);
+    for (int i(0); i < N; ++i)
+    {
+        KeyData const kd(tk_ver, keys[i].key_parts, keys[i].key_parts_num,
+                         WSREP_KEY_EXCLUSIVE, true);
+        size1 += kso1.append(kd);
+    }
+
+    gu::byte_t reserved2[1024];
+    TestBaseName const str2("key_set_test_batch");
+    KeySetOut kso2 (reserved2, sizeof(reserved2), str2, tk_ver);
+
+    size_t const size2(kso2.append(tk_ver, &keys[0], keys.size(),
+                                   WSREP_KEY_EXCLUSIVE, true));
+
+    fail_if (size1 != size2, "single: %zu, batch: %zu", size1, size2);
+    fail_if (kso1.count() != kso2.count(), "single: %d, batch: %d",
+             kso1.count(), kso2.count());
+    /* 1 db + 2 tables + (N - 20) unique rows */
+    fail_if (kso2.count() != 3 + N - 20, "count: %d", kso2.count());
+}
+END_TEST
+
 Suite* key_set_suite ()
 {
     TCase* t = tcase_create ("KeySet");
     tcase_add_test (t, ver0);
+    tcase_add_test (t, batch);
     tcase_set_timeout(t, 60);
 
     Suite* s = suite_create ("KeySet");
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2016 Codership Oy <info@codership.com>
+ */
+
+#undef NDEBUG
+
+#include "../src/latency_trace.hpp"
+
+#include <check.h>
+
+#include <unistd.h>
+
+using namespace galera;
+
+static long long
+stage_count(const LatencyTrace& trace, LatencyTrace::Stage const s)
+{
+    gu::LogHistogram::Snapshot snap;
+    trace.snapshot(s, snap);
+    return snap.count();
+}
+
+START_TEST(latency_trace_record)
+{
+    LatencyTrace trace;
+    gu::LogHistogram::Snapshot snap;
+
+    fail_if(stage_count(trace, LatencyTrace::CERTIFY) != 0);
+
+    /* 990 x 10us, 9 x 1ms, 1 x 100ms */
+    for (int i(0); i < 990; ++i) trace.record(LatencyTrace::CERTIFY, 10000);
+    for (int i(0); i < 9;   ++i) trace.record(LatencyTrace::CERTIFY, 1000000);
+    trace.record(LatencyTrace::CERTIFY, 100000000);
+
+    trace.snapshot(LatencyTrace::CERTIFY, snap);
+    fail_if(snap.count() != 1000);
+
+    long long const p99(snap.percentile(0.99));
+    long long const p999(snap.percentile(0.999));
+    fail_if(p99  < 10000   || p99  > 11250,   "p99: %lld",  p99);
+    fail_if(p999 < 1000000 || p999 > 1125000, "p999: %lld", p999);
+
+    /* other stages are not affected */
+    fail_if(stage_count(trace, LatencyTrace::COMMIT) != 0);
+
+    trace.reset();
+    fail_if(stage_count(trace, LatencyTrace::CERTIFY) != 0);
+}
+END_TEST
+
+START_TEST(latency_trace_stages)
+{
+    LatencyTrace trace;
+    LatencyTrace::Times t;
+    gu::LogHistogram::Snapshot snap;
+
+    /* disabled trace does not record anything */
+    trace.start(t);
+    trace.mark(LatencyTrace::REPLICATE, t);
+    trace.finish(LatencyTrace::COMMIT, t);
+
+    fail_if(stage_count(trace, LatencyTrace::REPLICATE) != 0);
+    fail_if(stage_count(trace, LatencyTrace::TOTAL) != 0);
+
+    trace.set_enabled(true);
+
+    trace.start(t);
+    usleep(2000);
+    trace.mark(LatencyTrace::REPLICATE, t);
+    trace.finish(LatencyTrace::COMMIT, t);
+
+    trace.snapshot(LatencyTrace::REPLICATE, snap);
+    fail_if(snap.count() != 1);
+    fail_if(snap.max() < 2000000, "replicate: %lld", snap.max());
+    fail_if(stage_count(trace, LatencyTrace::COMMIT) != 1);
+    trace.snapshot(LatencyTrace::TOTAL, snap);
+    fail_if(snap.count() != 1);
+    fail_if(snap.max() < 2000000, "total: %lld", snap.max());
+
+    /* finished trx is not traced any more */
+    trace.mark(LatencyTrace::CERTIFY, t);
+    fail_if(stage_count(trace, LatencyTrace::CERTIFY) != 0);
+
+    gu::Status status;
+    trace.get_status(status);
+    fail_if(status.size() != LatencyTrace::STAGE_MAX);
+}
+END_TEST
+
+Suite* latency_trace_suite()
+{
+    Suite* s = suite_create("LatencyTrace");
+    TCase* tc;
+
+    tc = tcase_create("latency_trace");
+    tcase_add_test(tc, latency_trace_record);
+    tcase_add_test(tc, latency_trace_stages);
+    suite_add_tcase(s, tc);
+
+    return s;
+}
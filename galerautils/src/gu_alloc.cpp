@@ -29,14 +29,20 @@ gu::Allocator::HeapStore::my_new_page (page_size_type const size)
         /* to avoid too frequent allocation, make it (at least) 64K */
         static page_size_type const PAGE_SIZE(gu_page_size_multiple(1 << 16));
 
-        page_size_type const page_size
-            (std::min(std::max(size, PAGE_SIZE), left_));
+        Page* ret = cache_ ? cache_->get_heap(size, left_) : 0;
 
-        Page* ret = new HeapPage (page_size);
+        if (0 == ret)
+        {
+            page_size_type const page_size
+                (std::min(std::max(size, PAGE_SIZE), left_));
+
+            ret = new HeapPage (page_size);
+        }
 
         assert (ret != 0);
+        assert (ret->capacity() <= left_);
 
-        left_ -= page_size;
+        left_ -= ret->capacity();
 
         return ret;
     }
@@ -65,7 +71,13 @@ gu::Allocator::FilePage::FilePage (const std::string& name,
 gu::Allocator::Page*
 gu::Allocator::FileStore::my_new_page (page_size_type const size)
 {
-    Page* ret = 0;
+    Page* ret = cache_ ? cache_->get_file(std::max(size, page_size_)) : 0;
+
+    if (ret)
+    {
+        ++n_;
+        return ret;
+    }
 
     try {
         std::ostringstream fname;
@@ -174,13 +186,15 @@ gu::Allocator::Allocator (const BaseName&         base_name,
                           byte_t*                 reserved,
                           page_size_type          reserved_size,
                           heap_size_type          max_ram,
-                          page_size_type          disk_page_size)
+                          page_size_type          disk_page_size,
+                          PageCache*              cache)
         :
     first_page_   (reserved, reserved_size),
     current_page_ (&first_page_),
-    heap_store_   (max_ram),
-    file_store_   (base_name, disk_page_size),
+    heap_store_   (max_ram, cache),
+    file_store_   (base_name, disk_page_size, cache),
     current_store_(&heap_store_),
+    cache_        (cache),
     pages_        (),
 #ifdef GU_ALLOCATOR_DEBUG
     bufs_         (),
@@ -199,6 +213,165 @@ gu::Allocator::~Allocator ()
          i > 0 /* don't delete first_page_ - we didn't allocate it */;
          --i)
     {
-        delete (pages_[i]);
+        if (0 == cache_ || !cache_->put(pages_[i])) delete (pages_[i]);
     }
 }
+
+
+gu::Allocator::PageCache::PageCache (size_t const max_heap,
+                                     int    const max_files)
+    :
+    mtx_      (),
+    heap_     (),
+    files_    (),
+    heap_size_(0),
+    max_heap_ (max_heap),
+    max_files_(max_files),
+    hits_     (0),
+    misses_   (0)
+{}
+
+
+gu::Allocator::PageCache::~PageCache ()
+{
+    set_limits (0, 0);
+}
+
+
+void
+gu::Allocator::PageCache::set_limits (size_t const max_heap,
+                                      int    const max_files)
+{
+    Lock lock(mtx_);
+
+    max_heap_  = max_heap;
+    max_files_ = max_files;
+
+    trim();
+}
+
+
+void
+gu::Allocator::PageCache::trim ()
+{
+    while (heap_size_ > max_heap_)
+    {
+        assert (!heap_.empty());
+        heap_size_ -= heap_.back()->capacity();
+        delete heap_.back();
+        heap_.pop_back();
+    }
+
+    while (files_.size() > size_t(std::max(max_files_, 0)))
+    {
+        delete files_.back();
+        files_.pop_back();
+    }
+}
+
+
+gu::Allocator::Page*
+gu::Allocator::PageCache::get (std::vector<Page*>& pages,
+                               size_t const min_size, size_t const max_size)
+{
+    for (size_t i(0); i < pages.size(); ++i)
+    {
+        Page* const ret(pages[i]);
+        size_t const cap(ret->capacity());
+
+        if (cap >= min_size && cap <= max_size)
+        {
+            pages[i] = pages.back();
+            pages.pop_back();
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+
+gu::Allocator::Page*
+gu::Allocator::PageCache::get_heap (size_t const min_size,
+                                    size_t const max_size)
+{
+    Lock lock(mtx_);
+
+    Page* const ret(get(heap_, min_size, max_size));
+
+    if (ret)
+    {
+        heap_size_ -= ret->capacity();
+        ++hits_;
+    }
+    else
+    {
+        ++misses_;
+    }
+
+    return ret;
+}
+
+
+gu::Allocator::Page*
+gu::Allocator::PageCache::get_file (size_t const min_size)
+{
+    Lock lock(mtx_);
+
+    Page* const ret(get(files_, min_size, size_t(-1)));
+
+    if (ret) ++hits_; else ++misses_;
+
+    return ret;
+}
+
+
+bool
+gu::Allocator::PageCache::put (Page* const page)
+{
+    page->reset();
+
+    size_t const cap(page->capacity());
+    bool   const file(dynamic_cast<FilePage*>(page) != 0);
+
+    Lock lock(mtx_);
+
+    if (file)
+    {
+        if (int(files_.size()) < max_files_)
+        {
+            files_.push_back(page);
+            return true;
+        }
+    }
+    else if (heap_size_ + cap <= max_heap_)
+    {
+        heap_.push_back(page);
+        heap_size_ += cap;
+        return true;
+    }
+
+    return false;
+}
+
+
+void
+gu::Allocator::PageCache::get_stats (Stats& stats) const
+{
+    Lock lock(mtx_);
+
+    stats.hits_   = hits_;
+    stats.misses_ = misses_;
+    stats.heap_   = heap_size_;
+    stats.files_  = files_.size();
+}
+
+
+void
+gu::Allocator::PageCache::flush_stats ()
+{
+    Lock lock(mtx_);
+
+    hits_   = 0;
+    misses_ = 0;
+}
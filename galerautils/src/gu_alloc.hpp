@@ -13,11 +13,13 @@
 #include "gu_mmap.hpp"
 #include "gu_buf.hpp"
 #include "gu_vector.hpp"
+#include "gu_lock.hpp"
 
 #include "gu_macros.h" // gu_likely()
 
 #include <cstdlib>     // realloc(), free()
 #include <string>
+#include <vector>
 #include <iostream>
 
 namespace gu
@@ -39,12 +41,19 @@ public:
     typedef unsigned int   page_size_type; // max page size
     typedef page_size_type heap_size_type; // max heap store size
 
+    static heap_size_type const DEFAULT_MAX_HEAP       = (1U << 22); /* 4M  */
+    static page_size_type const DEFAULT_DISK_PAGE_SIZE = (1U << 26); /* 64M */
+
+    class PageCache;
+
+    /*! @param cache - if not NULL, pages are taken from and returned to it */
     explicit
     Allocator (const BaseName&     base_name      = BASE_NAME_DEFAULT,
                byte_t*             reserved       = NULL,
                page_size_type      reserved_size  = 0,
-               heap_size_type      max_heap       = (1U << 22),   /* 4M  */
-               page_size_type      disk_page_size = (1U << 26));  /* 64M */
+               heap_size_type      max_heap       = DEFAULT_MAX_HEAP,
+               page_size_type      disk_page_size = DEFAULT_DISK_PAGE_SIZE,
+               PageCache*          cache          = NULL);
 
     ~Allocator ();
 
@@ -99,6 +108,12 @@ private:
         const byte_t* base() const { return base_ptr_; }
         ssize_t       size() const { return ptr_ - base_ptr_; }
 
+        /* total page capacity */
+        size_t capacity() const { return size() + left_; }
+
+        /* makes the whole page available for allocation again */
+        void reset() { left_ += ptr_ - base_ptr_; ptr_ = base_ptr_; }
+
     protected:
 
         byte_t*        base_ptr_;
@@ -151,15 +166,20 @@ private:
     {
     public:
 
-        HeapStore (heap_size_type max) : PageStore(), left_(max) {}
+        HeapStore (heap_size_type max, PageCache* cache)
+            : PageStore(), left_(max), cache_(cache) {}
 
         ~HeapStore () {}
 
     private:
 
         heap_size_type left_;
+        PageCache*     cache_;
 
         Page* my_new_page (page_size_type const size);
+
+        HeapStore (const HeapStore&);
+        HeapStore& operator= (const HeapStore&);
     };
 
     class FileStore : public PageStore
@@ -167,12 +187,14 @@ private:
     public:
 
         FileStore (const BaseName& base_name,
-                   page_size_type  page_size)
+                   page_size_type  page_size,
+                   PageCache*      cache)
             :
             PageStore(),
             base_name_(base_name),
             page_size_(page_size),
-            n_        (0)
+            n_        (0),
+            cache_    (cache)
         {}
 
         ~FileStore() {}
@@ -185,6 +207,7 @@ private:
         const BaseName&      base_name_;
         page_size_type const page_size_;
         int                  n_;
+        PageCache*           cache_;
 
         Page* my_new_page (page_size_type const size);
 
@@ -198,6 +221,7 @@ private:
     HeapStore  heap_store_;
     FileStore  file_store_;
     PageStore* current_store_;
+    PageCache* cache_;
 
     gu::Vector<Page*, INITIAL_VECTOR_SIZE> pages_;
 
@@ -222,6 +246,67 @@ private:
 
 }; /* class Allocator */
 
+
+/*! Keeps pages released by allocators for reuse by subsequent allocators
+ *  to avoid repeated allocation and freeing of the same memory (or creation
+ *  and removal of the same files). Can be shared between threads. */
+class Allocator::PageCache
+{
+public:
+
+    struct Stats
+    {
+        long long hits_;   // page requests served from cache
+        long long misses_; // page requests that had to allocate a new page
+        size_t    heap_;   // bytes in cached heap pages
+        int       files_;  // cached file pages
+    };
+
+    explicit
+    PageCache (size_t max_heap  = DEFAULT_MAX_HEAP,
+               int    max_files = 0);
+
+    ~PageCache ();
+
+    /*! sets cache limits, pages in excess are freed */
+    void set_limits (size_t max_heap, int max_files);
+
+    void get_stats (Stats& stats) const;
+
+    void flush_stats ();
+
+private:
+
+    friend class Allocator;
+
+    /* returns a cached heap page of capacity in [min_size, max_size] range
+     * or NULL if there is none */
+    Page* get_heap (size_t min_size, size_t max_size);
+
+    /* returns a cached file page of at least min_size capacity or NULL */
+    Page* get_file (size_t min_size);
+
+    /* takes ownership of the page if there is room for it in the cache */
+    bool  put (Page* page);
+
+    static Page* get (std::vector<Page*>& pages,
+                      size_t min_size, size_t max_size);
+
+    void  trim ();
+
+    mutable Mutex      mtx_;
+    std::vector<Page*> heap_;
+    std::vector<Page*> files_;
+    size_t             heap_size_;
+    size_t             max_heap_;
+    int                max_files_;
+    long long          hits_;
+    long long          misses_;
+
+    PageCache (const PageCache&);
+    PageCache& operator= (const PageCache&);
+}; /* class Allocator::PageCache */
+
 inline
 std::ostream& operator<< (std::ostream& os, const Allocator::BaseName& bn)
 {
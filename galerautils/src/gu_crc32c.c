@@ -31,3 +31,14 @@ gu_crc32c_configure()
         abort();
     }
 }
+
+int
+gu_crc32c_hardware()
+{
+#if !defined(CRC32C_NO_HARDWARE)
+    return (gu_crc32c_func == crc32cHardware64 ||
+            gu_crc32c_func == crc32cHardware32);
+#else
+    return 0;
+#endif /* !CRC32C_NO_HARDWARE */
+}
@@ -23,6 +23,11 @@ gu_crc32c_configure();
 
 extern CRC32CFunctionPtr gu_crc32c_func;
 
+/*! Returns non-zero if configured CRC32C implementation uses hardware
+ *  acceleration (call gu_crc32c_configure() first) */
+extern int
+gu_crc32c_hardware();
+
 typedef uint32_t gu_crc32c_t;
 
 static gu_crc32c_t const GU_CRC32C_INIT = 0xFFFFFFFF;
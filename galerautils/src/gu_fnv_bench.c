@@ -14,6 +14,8 @@
  *
  * To run:
  * gu_fnv_bench <buffer size> <N loops>
+ *
+ * On x86 throughput is also reported in bytes per TSC cycle.
  */
 
 #include "gu_crc32c.h"
@@ -27,6 +29,13 @@
 #include <sys/time.h>
 #include <errno.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES() ((long long)__rdtsc())
+#else
+#define BENCH_CYCLES() (0LL)
+#endif
+
 #include <openssl/md5.h>
 
 #define CRYPTOPP_ENABLE_NAMESPACE_WEAK 1
@@ -59,6 +68,7 @@ static int timer (const void* const buf, ssize_t const len,
     size_t volatile h; // this variable serves to prevent compiler from
                        // optimizing out the calls
 
+    long long cycles = BENCH_CYCLES();
     gettimeofday (&tv, NULL); begin = (double)tv.tv_sec + 1.e-6 * tv.tv_usec;
 
     long long i;
@@ -204,10 +214,13 @@ static int timer (const void* const buf, ssize_t const len,
     EXTERNAL_LOOP_END
 
     gettimeofday (&tv, NULL); end   = (double)tv.tv_sec + 1.e-6 * tv.tv_usec;
+    cycles = BENCH_CYCLES() - cycles;
 
     end -= begin;
-    return printf ("%s: %lld loops, %6.3f seconds, %8.3f Mb/sec%s\n",
+    return printf ("%s: %lld loops, %6.3f seconds, %8.3f Mb/sec, "
+                   "%6.3f bytes/cycle%s\n",
                    alg, loops, end, (double)(loops * len)/end/1024/1024,
+                   cycles > 0 ? (double)(loops * len)/cycles : 0.0,
                    h ? "" : " ");
 }
 
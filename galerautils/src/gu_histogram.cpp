@@ -11,10 +11,12 @@
 
 #include <sstream>
 #include <limits>
-#include <vector>
+#include <algorithm>
+#include <cassert>
 
 gu::Histogram::Histogram(const std::string& vals)
     :
+    edges_(),
     cnt_()
 {
     std::vector<std::string> varr = gu::strsplit(vals, ',');
@@ -32,11 +34,17 @@ gu::Histogram::Histogram(const std::string& vals)
             gu_throw_fatal << "Parse error";
         }
 
-        if (cnt_.insert(std::make_pair(val, 0)).second == false)
-        {
-            gu_throw_fatal << "Failed to insert value: " << val;
-        }
+        edges_.push_back(val);
     }
+
+    std::sort(edges_.begin(), edges_.end());
+
+    if (std::adjacent_find(edges_.begin(), edges_.end()) != edges_.end())
+    {
+        gu_throw_fatal << "Failed to insert value: duplicate bin edge";
+    }
+
+    cnt_.resize(edges_.size());
 }
 
 void gu::Histogram::insert(const double val)
@@ -47,50 +55,41 @@ void gu::Histogram::insert(const double val)
         return;
     }
 
-    // Returns element that has key greater to val,
+    // Returns edge that is greater than val,
     // the correct bin is one below that
-    std::map<double, long long>::iterator i(cnt_.upper_bound(val));
+    std::vector<double>::const_iterator const i(
+        std::upper_bound(edges_.begin(), edges_.end(), val));
 
-    if (i == cnt_.end())
-    {
-        ++cnt_.rbegin()->second;
-    }
-    else if (i == cnt_.begin())
+    if (i == edges_.begin())
     {
         log_warn << "value " << val << " below histogram range, discarding";
     }
     else
     {
-        --i;
-        ++i->second;
+        cnt_[i - edges_.begin() - 1].add_and_fetch(1);
     }
 }
 
 void gu::Histogram::clear()
 {
-    for (std::map<double, long long>::iterator i = cnt_.begin();
-         i != cnt_.end(); ++i)
-    {
-        i->second = 0;
-    }
+    for (size_t i(0); i < cnt_.size(); ++i) cnt_[i] = 0;
 }
 
 std::ostream& gu::operator<<(std::ostream& os, const Histogram& hs)
 {
-    std::map<double, long long>::const_iterator i, i_next;
+    std::vector<long long> cnt(hs.cnt_.size());
 
     long long norm = 0;
-    for (i = hs.cnt_.begin(); i != hs.cnt_.end(); ++i)
+    for (size_t i(0); i < cnt.size(); ++i)
     {
-        norm += i->second;
+        cnt[i] = hs.cnt_[i]();
+        norm += cnt[i];
     }
 
-    for (i = hs.cnt_.begin(); i != hs.cnt_.end(); i = i_next)
+    for (size_t i(0); i < cnt.size(); ++i)
     {
-        i_next = i;
-        ++i_next;
-        os << i->first << ":" << std::fabs(double(i->second)/double(norm));
-        if (i_next != hs.cnt_.end()) os << ",";
+        os << hs.edges_[i] << ":" << std::fabs(double(cnt[i])/double(norm));
+        if (i + 1 < cnt.size()) os << ",";
     }
 
     return os;
@@ -103,3 +102,117 @@ std::string gu::Histogram::to_string() const
     os << *this;
     return os.str();
 }
+
+
+gu::LogHistogram::Snapshot::Snapshot() : count_(0), sum_(0)
+{
+    std::fill(cnt_, cnt_ + BUCKETS, 0);
+}
+
+void
+gu::LogHistogram::Snapshot::merge(const Snapshot& other)
+{
+    for (int b(0); b < BUCKETS; ++b) cnt_[b] += other.cnt_[b];
+
+    count_ += other.count_;
+    sum_   += other.sum_;
+}
+
+long long
+gu::LogHistogram::Snapshot::percentile(double const p) const
+{
+    if (0 == count_) return 0;
+
+    long long rank(std::ceil(p * count_));
+
+    if (rank < 1)      rank = 1;
+    if (rank > count_) rank = count_;
+
+    long long sum(0);
+
+    for (int b(0); b < BUCKETS; ++b)
+    {
+        sum += cnt_[b];
+        if (sum >= rank) return bucket_high(b);
+    }
+
+    assert(0);
+    return max();
+}
+
+long long
+gu::LogHistogram::Snapshot::min() const
+{
+    for (int b(0); b < BUCKETS; ++b)
+    {
+        if (cnt_[b] > 0) return bucket_low(b);
+    }
+
+    return 0;
+}
+
+long long
+gu::LogHistogram::Snapshot::max() const
+{
+    for (int b(BUCKETS - 1); b >= 0; --b)
+    {
+        if (cnt_[b] > 0) return bucket_high(b);
+    }
+
+    return 0;
+}
+
+void
+gu::LogHistogram::Snapshot::print_percentiles(std::ostream& os,
+                                              long long const unit) const
+{
+    os << percentile(0.5)   / unit << '/'
+       << percentile(0.99)  / unit << '/'
+       << percentile(0.999) / unit;
+}
+
+gu::LogHistogram::LogHistogram() : cnt_(), sum_() {}
+
+void
+gu::LogHistogram::snapshot(Snapshot& s) const
+{
+    s.count_ = 0;
+
+    for (int b(0); b < BUCKETS; ++b)
+    {
+        s.cnt_[b] = cnt_[b]();
+        s.count_ += s.cnt_[b];
+    }
+
+    s.sum_ = sum_();
+}
+
+void
+gu::LogHistogram::clear()
+{
+    for (int b(0); b < BUCKETS; ++b) cnt_[b] = 0;
+
+    sum_ = 0;
+}
+
+long long
+gu::LogHistogram::bucket_low(int const b)
+{
+    if (b < 2 * SUB_BUCKETS) return b;
+
+    int const shift(b / SUB_BUCKETS - 1);
+
+    return static_cast<long long>(b - shift * SUB_BUCKETS) << shift;
+}
+
+long long
+gu::LogHistogram::bucket_high(int const b)
+{
+    if (b < 2 * SUB_BUCKETS) return b;
+
+    int const shift(b / SUB_BUCKETS - 1);
+
+    if (b == BUCKETS - 1) return std::numeric_limits<long long>::max();
+
+    return bucket_low(b) + (1LL << shift) - 1;
+}
@@ -5,11 +5,19 @@
 #ifndef _gu_histogram_hpp_
 #define _gu_histogram_hpp_
 
-#include <map>
+#include "gu_atomic.hpp"
+#include "gu_macros.h"
+
+#include <vector>
+#include <string>
 #include <ostream>
 
 namespace gu
 {
+    /*! Histogram with arbitrary bin edges, reports fraction of values in
+     *  each bin. Edges are kept in a sorted array and counters are atomic,
+     *  so insert() is a binary search plus atomic increment and can be called
+     *  concurrently. */
     class Histogram
     {
     public:
@@ -19,10 +27,104 @@ namespace gu
         friend std::ostream& operator<<(std::ostream&, const Histogram&);
         std::string to_string() const;
     private:
-        std::map<double, long long> cnt_;
+        std::vector<double>                edges_;
+        std::vector<gu::Atomic<long long> > cnt_;
     };
 
     std::ostream& operator<<(std::ostream&, const Histogram&);
+
+    /*!
+     * HDR-style log-linear histogram of non-negative integer values
+     * (e.g. nanoseconds or queue lengths).
+     *
+     * Values below 2*SUB_BUCKETS are counted exactly, larger values fall into
+     * SUB_BUCKETS linear sub-buckets per power of two, so relative error of
+     * reported values does not exceed 1/SUB_BUCKETS. Counters live in a fixed
+     * array and are updated with atomic increments, so insert() does not
+     * allocate, lock or search and is safe to call from many threads.
+     */
+    class LogHistogram
+    {
+    public:
+
+        static int const SUB_BITS    = 3;
+        static int const SUB_BUCKETS = 1 << SUB_BITS;
+        static int const BUCKETS     = (64 - SUB_BITS) * SUB_BUCKETS;
+
+        /*! Point-in-time copy of counters. Snapshots can be merged and
+         *  queried without affecting the live histogram. */
+        class Snapshot
+        {
+        public:
+
+            Snapshot();
+
+            /*! adds counts from other snapshot */
+            void merge(const Snapshot& other);
+
+            long long count() const { return count_; }
+            long long sum()   const { return sum_;   }
+            double    mean()  const
+            {
+                return count_ > 0 ? double(sum_) / count_ : 0.0;
+            }
+
+            /*! @return highest value equivalent to the one at given
+             *          percentile (0.0 - 1.0), 0 if empty */
+            long long percentile(double p) const;
+
+            long long min() const;
+            long long max() const;
+
+            /*! writes "p50/p99/p999" with values divided by unit */
+            void print_percentiles(std::ostream& os, long long unit = 1)
+                const;
+
+        private:
+
+            friend class LogHistogram;
+
+            long long cnt_[BUCKETS];
+            long long count_;
+            long long sum_;
+        };
+
+        LogHistogram();
+
+        void insert(long long const val)
+        {
+            if (gu_unlikely(val < 0)) return;
+
+            cnt_[bucket(val)].add_and_fetch(1);
+            sum_.add_and_fetch(val);
+        }
+
+        void snapshot(Snapshot& s) const;
+
+        void clear();
+
+        /*! bucket index for value */
+        static int bucket(long long val)
+        {
+            if (val < 2 * SUB_BUCKETS) return val;
+
+            int const shift(63 - __builtin_clzll(val) - SUB_BITS);
+
+            return shift * SUB_BUCKETS + int(val >> shift);
+        }
+
+        /*! lowest and highest values counted in bucket */
+        static long long bucket_low (int b);
+        static long long bucket_high(int b);
+
+    private:
+
+        gu::Atomic<long long> cnt_[BUCKETS];
+        gu::Atomic<long long> sum_;
+
+        LogHistogram(const LogHistogram&);
+        LogHistogram& operator=(const LogHistogram&);
+    };
 }
 
 #endif // _gu_histogram_hpp_
@@ -115,6 +115,8 @@ gu_log_cb_default (int severity, const char* msg)
  */
 gu_log_cb_t gu_log_cb = gu_log_cb_default;
 
+gu_log_cb_t gu_log_sink = NULL;
+
 int
 gu_conf_set_log_callback (gu_log_cb_t callback)
 {
@@ -175,7 +177,12 @@ gu_log (gu_log_severity_t severity,
     }
 
     /* actual logging */
-    gu_log_cb (severity, string);
+    {
+        gu_log_cb_t const sink = gu_log_sink;
+
+        if (sink) sink      (severity, string);
+        else      gu_log_cb (severity, string);
+    }
 
     return 0;
 }
@@ -61,6 +61,10 @@ gu_log (gu_log_severity_t severity,
  *  Don't use it directly! */
 extern gu_log_severity_t gu_log_max_level;
 
+/** When set, formatted messages are passed to this function instead of
+ *  the logging callback (see gu::AsyncLog). */
+extern gu_log_cb_t gu_log_sink;
+
 #define gu_log_debug (GU_LOG_DEBUG == gu_log_max_level)
 
 #if defined(__cplusplus)
@@ -0,0 +1,299 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+#include "gu_log_async.hpp"
+
+#include "gu_atomic.hpp"
+#include "gu_lock.hpp"
+#include "gu_logger.hpp"
+#include "gu_throw.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+namespace
+{
+    /*
+     * Bounded multi-producer single-consumer queue after Dmitry Vyukov.
+     * Each slot carries a sequence number telling whether it is free
+     * for the producer at position pos (seq == pos) or holds a message
+     * for the consumer at position pos (seq == pos + 1).
+     */
+    class LogQueue
+    {
+    public:
+
+        LogQueue() : head_(0), tail_(0), overflows_(0)
+        {
+            for (size_t i(0); i < SIZE; ++i)
+            {
+                slots_[i].seq_ = i;
+                slots_[i].msg_ = NULL;
+            }
+        }
+
+        /*! takes ownership of msg on success
+         *  @return false if queue is full */
+        bool push(int const severity, char* const msg)
+        {
+            long long pos(load(tail_));
+
+            for (;;)
+            {
+                Slot& slot(slots_[pos & MASK]);
+                long long const diff(load(slot.seq_) - pos);
+
+                if (0 == diff)
+                {
+                    if (__sync_bool_compare_and_swap(&tail_, pos, pos + 1))
+                        break;
+                    pos = load(tail_);
+                }
+                else if (diff < 0)
+                {
+                    return false; // full
+                }
+                else
+                {
+                    pos = load(tail_);
+                }
+            }
+
+            Slot& slot(slots_[pos & MASK]);
+
+            slot.msg_ = msg;
+            slot.severity_ = severity;
+            store(slot.seq_, pos + 1);
+
+            return true;
+        }
+
+        /*! to be called by consumer only */
+        bool empty() const
+        {
+            return (load(slots_[head_ & MASK].seq_) != head_ + 1);
+        }
+
+        /*! @return false if queue is empty */
+        bool pop(int& severity, char*& msg)
+        {
+            if (empty()) return false;
+
+            Slot& slot(slots_[head_ & MASK]);
+
+            severity  = slot.severity_;
+            msg       = slot.msg_;
+            slot.msg_ = NULL;
+            store(slot.seq_, head_ + SIZE);
+            ++head_;
+
+            return true;
+        }
+
+        gu::Atomic<long long>& overflows() { return overflows_; }
+
+    private:
+
+        static size_t const SIZE = gu::AsyncLog::QUEUE_SIZE;
+        static size_t const MASK = SIZE - 1;
+
+        static long long load(const long long& var)
+        {
+            long long ret;
+            gu_atomic_get(&var, &ret);
+            return ret;
+        }
+
+        static void store(long long& var, long long val)
+        {
+            gu_atomic_set(&var, &val);
+        }
+
+        struct Slot
+        {
+            long long seq_;
+            int       severity_;
+            char*     msg_;
+        };
+
+        Slot                  slots_[SIZE];
+        long long             head_; // consumer only
+        long long             tail_;
+        gu::Atomic<long long> overflows_;
+    };
+
+    // The queue is allocated on first start and never deallocated: a thread
+    // which picked up the sink before stop() reset it may still use it.
+    LogQueue*   queue   (NULL);
+    gu_thread_t writer;
+    gu::Mutex   mtx;     // serializes start() and stop()
+
+    // Consumer side: whoever holds wmtx may pop messages from the queue.
+    // running and waiting are modified only under wmtx, but read by
+    // producers without it.
+    gu::Mutex   wmtx;
+    gu::Cond    wcond;
+    bool        running (false);
+    bool        waiting (false); // writer is about to sleep or sleeping
+
+    bool load(const bool& var)
+    {
+        bool ret;
+        gu_atomic_get(&var, &ret);
+        return ret;
+    }
+
+    void store(bool& var, bool const val)
+    {
+        gu_atomic_set(&var, &val);
+    }
+
+    // to be called under wmtx
+    void drain()
+    {
+        int   severity;
+        char* msg;
+
+        while (queue->pop(severity, msg))
+        {
+            gu_log_cb(severity, msg);
+            ::free(msg);
+        }
+    }
+
+    extern "C" void log_async(int const severity, const char* const msg)
+    {
+        if (gu_unlikely(GU_LOG_FATAL == severity))
+        {
+            // preserve the order of messages leading to the fatal one
+            {
+                gu::Lock lock(wmtx);
+                drain();
+            }
+            gu_log_cb(severity, msg);
+            return;
+        }
+
+        char* const copy(::strdup(msg));
+
+        if (gu_unlikely(NULL == copy))
+        {
+            gu_log_cb(severity, msg);
+            return;
+        }
+
+        if (gu_unlikely(!queue->push(severity, copy)))
+        {
+            ::free(copy);
+            queue->overflows().add_and_fetch(1);
+            gu_log_cb(severity, msg);
+            return;
+        }
+
+        // The message is in the queue before running and waiting are read,
+        // and the writer sets them before it looks at the queue, so either
+        // the writer sees the message or the message sees the writer.
+        if (gu_unlikely(!load(running)))
+        {
+            // stop() has already made its final pass, write it out here
+            gu::Lock lock(wmtx);
+            drain();
+        }
+        else if (load(waiting))
+        {
+            gu::Lock lock(wmtx);
+            wcond.signal();
+        }
+    }
+
+    extern "C" void* writer_thread(void*)
+    {
+        gu::Lock lock(wmtx);
+
+        for (;;)
+        {
+            bool const run(running);
+
+            drain();
+
+            if (!run) break;
+
+            store(waiting, true);
+            if (queue->empty()) lock.wait(wcond);
+            store(waiting, false);
+        }
+
+        return NULL;
+    }
+}
+
+void
+gu::AsyncLog::start()
+{
+    gu::Lock lock(mtx);
+
+    if (gu_log_sink == log_async) return;
+
+    if (!queue) queue = new LogQueue;
+
+    {
+        gu::Lock wlock(wmtx);
+        store(running, true);
+    }
+
+    int const err(gu_thread_create(&writer, NULL, writer_thread, NULL));
+
+    if (err)
+    {
+        gu::Lock wlock(wmtx);
+        store(running, false);
+        gu_throw_error(err) << "Failed to start async log writer";
+    }
+
+    gu_log_sink = log_async;
+
+    log_info << "Asynchronous logging enabled";
+}
+
+void
+gu::AsyncLog::stop()
+{
+    gu::Lock lock(mtx);
+
+    if (gu_log_sink != log_async) return;
+
+    gu_log_sink = NULL;
+
+    {
+        gu::Lock wlock(wmtx);
+        store(running, false);
+        wcond.signal();
+    }
+
+    gu_thread_join(writer, NULL);
+
+    {
+        // in case something was queued after writer's last pass
+        gu::Lock wlock(wmtx);
+        drain();
+    }
+
+    log_info << "Asynchronous logging disabled, "
+             << queue->overflows()() << " messages were written synchronously";
+}
+
+bool
+gu::AsyncLog::started()
+{
+    gu::Lock lock(mtx);
+    return (gu_log_sink == log_async);
+}
+
+long long
+gu::AsyncLog::overflows()
+{
+    gu::Lock lock(mtx);
+    return queue ? queue->overflows()() : 0;
+}
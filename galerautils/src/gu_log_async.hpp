@@ -0,0 +1,48 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+/*!
+ * @file Asynchronous log sink.
+ *
+ * When started, formatted log messages from both C and C++ loggers are
+ * copied into a bounded lock-free queue and written to the logging callback
+ * by a background thread, so that logging threads do not wait for log I/O.
+ *
+ * Messages keep their order except for those logged while the queue is
+ * full or cannot be copied, which are written synchronously rather than
+ * dropped. FATAL messages are written synchronously after the queue has
+ * been drained, as the process is likely to abort right after. The writer
+ * thread sleeps while the queue is empty and is woken up by the next
+ * message. Messages which reach the queue after stop() are written out by
+ * the logging thread itself.
+ */
+
+#ifndef GU_LOG_ASYNC_HPP
+#define GU_LOG_ASYNC_HPP
+
+#include <cstddef>
+
+namespace gu
+{
+    class AsyncLog
+    {
+    public:
+
+        static size_t const QUEUE_SIZE = 1024; // must be a power of 2
+
+        /*! starts background writer, no-op if already started */
+        static void start();
+
+        /*! writes out queued messages and stops background writer,
+         *  no-op if not started */
+        static void stop();
+
+        static bool started();
+
+        /*! messages written synchronously because the queue was full */
+        static long long overflows();
+    };
+}
+
+#endif // GU_LOG_ASYNC_HPP
@@ -70,7 +70,7 @@ namespace gu
     }
 
     bool
-    Logger::no_debug(const string& file, const string& func, const int line)
+    Logger::no_debug(const char* file, const char* func, int line)
     {
         return debug_filter.size() > 0 && debug_filter.is_set(func) == false;
     }
@@ -71,7 +71,14 @@ namespace gu
             os     ()
         {}
 
-        virtual ~Logger() { logger (level, os.str().c_str()); }
+        virtual ~Logger()
+        {
+#ifdef _gu_log_h_
+            gu_log_cb_t const sink(gu_log_sink);
+            if (sink) { sink (level, os.str().c_str()); return; }
+#endif
+            logger (level, os.str().c_str());
+        }
 
         std::ostringstream& get(const char* file,
                                 const char* func,
@@ -98,7 +105,7 @@ namespace gu
 
         static void set_debug_filter(const std::string&);
 
-        static bool no_debug(const std::string&, const std::string&, const int);
+        static bool no_debug(const char* file, const char* func, int line);
 
 #ifndef _gu_log_h_
         static void enable_tstamp (bool);
@@ -107,6 +114,8 @@ namespace gu
 #endif
     };
 
+// Nothing is constructed and no arguments are evaluated unless the message
+// is going to be logged.
 #define GU_LOG_CPP(level)                                               \
     if (gu::Logger::no_log(level)) {}                                   \
     else gu::Logger(level).get(__FILE__, __FUNCTION__, __LINE__)
@@ -117,9 +126,12 @@ namespace gu
 #define log_error GU_LOG_CPP(gu::LOG_ERROR)
 #define log_warn  GU_LOG_CPP(gu::LOG_WARN)
 #define log_info  GU_LOG_CPP(gu::LOG_INFO)
+// level is checked first, so that debug filter is not consulted when
+// debug logging is off
 #define log_debug                                                       \
-    if (gu::Logger::no_debug(__FILE__, __FUNCTION__, __LINE__)) {} else \
-        GU_LOG_CPP(gu::LOG_DEBUG)
+    if (gu_likely(gu::Logger::no_log(gu::LOG_DEBUG)) ||                 \
+        gu::Logger::no_debug(__FILE__, __FUNCTION__, __LINE__)) {}      \
+    else gu::Logger(gu::LOG_DEBUG).get(__FILE__, __FUNCTION__, __LINE__)
 }
 
 #endif // __GU_LOGGER__
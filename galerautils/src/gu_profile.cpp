@@ -0,0 +1,283 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+#include "gu_profile.hpp"
+#include "gu_atomic.hpp"
+#include "gu_throw.hpp"
+
+#include <pthread.h>
+
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+    struct Event
+    {
+        long long   tstamp_;
+        const char* file_;
+        const char* func_;
+        int         line_;
+        int         thread_; // sequential thread number
+        bool        enter_;
+    };
+
+    /* Events are written by the owner thread only. Readers copy events
+     * and then discard those which may have been overwritten meanwhile. */
+    class Ring
+    {
+    public:
+
+        explicit Ring(size_t const size)
+            :
+            pos_(0), start_(0), thread_(0), free_(false),
+            size_(size), mask_(size - 1), events_(new Event[size])
+        {}
+
+        ~Ring() { delete[] events_; }
+
+        void push(const char* const file, const char* const func,
+                  int const line, bool const enter)
+        {
+            Event& e(events_[pos_ & mask_]);
+
+            e.tstamp_ = gu_time_monotonic();
+            e.file_   = file;
+            e.func_   = func;
+            e.line_   = line;
+            e.thread_ = thread_;
+            e.enter_  = enter;
+
+            long long const next(pos_ + 1);
+            gu_atomic_set(&pos_, &next);
+        }
+
+        /*! appends recorded events in order to v */
+        void copy(std::vector<Event>& v) const
+        {
+            long long end, start;
+            gu_atomic_get(&pos_, &end);
+            gu_atomic_get(&start_, &start);
+
+            long long const size(size_);
+            long long const begin(std::max(start, end - size));
+            size_t const old_size(v.size());
+
+            for (long long i(begin); i < end; ++i)
+            {
+                v.push_back(events_[i & mask_]);
+            }
+
+            long long after;
+            gu_atomic_get(&pos_, &after);
+
+            // events up to after - size could have been overwritten, the
+            // last one by the push in progress
+            long long const lost(after - size - begin + 1);
+
+            if (lost > 0)
+            {
+                v.erase(v.begin() + old_size,
+                        v.begin() + old_size + std::min(lost, end - begin));
+            }
+        }
+
+        void clear()
+        {
+            long long pos;
+            gu_atomic_get(&pos_, &pos);
+            gu_atomic_set(&start_, &pos);
+        }
+
+        size_t size() const { return size_; }
+
+        long long pos_;
+        long long start_;
+        int       thread_;
+        bool      free_;   // owner thread has exited
+
+    private:
+
+        Ring(const Ring&);
+        Ring& operator=(const Ring&);
+
+        size_t const size_;
+        size_t const mask_;
+        Event* const events_;
+    };
+
+    gu::Mutex          rings_mtx;
+    std::vector<Ring*> rings;
+    size_t             new_ring_size(gu::prof::Trace::DEFAULT_RING_SIZE);
+    int                threads(0);
+    pthread_key_t      ring_key;
+    pthread_once_t     ring_key_once = PTHREAD_ONCE_INIT;
+
+    extern "C" void release_ring(void* const arg)
+    {
+        Ring* const ring(static_cast<Ring*>(arg));
+        gu::Lock lock(rings_mtx);
+        ring->free_ = true;
+    }
+
+    // to be called under rings_mtx, keeps the rings for which keep is true
+    template <typename Keep>
+    void free_rings(Keep keep)
+    {
+        std::vector<Ring*>::iterator i(rings.begin());
+
+        while (i != rings.end())
+        {
+            if ((*i)->free_ && !keep(**i))
+            {
+                delete *i;
+                i = rings.erase(i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    bool keep_none(const Ring&) { return false; }
+
+    bool keep_current_size(const Ring& ring)
+    {
+        return ring.size() == new_ring_size;
+    }
+
+    extern "C" void create_ring_key()
+    {
+        pthread_key_create(&ring_key, release_ring);
+    }
+
+    Ring* acquire_ring()
+    {
+        Ring* ring(NULL);
+        {
+            gu::Lock lock(rings_mtx);
+
+            // rings of the size no longer in use are not worth reusing
+            free_rings(keep_current_size);
+
+            for (size_t i(0); i < rings.size(); ++i)
+            {
+                if (rings[i]->free_) { ring = rings[i]; break; }
+            }
+
+            if (!ring)
+            {
+                ring = new Ring(new_ring_size);
+                rings.push_back(ring);
+            }
+
+            ring->free_   = false;
+            ring->thread_ = ++threads;
+        }
+
+        pthread_setspecific(ring_key, ring);
+
+        return ring;
+    }
+}
+
+size_t const gu::prof::Trace::DEFAULT_RING_SIZE;
+
+bool gu::prof::Trace::enabled_(false);
+
+void
+gu::prof::Trace::set_ring_size(size_t const size)
+{
+    if (0 == size || (size & (size - 1)))
+    {
+        gu_throw_error(EINVAL) << "Profile ring size " << size
+                               << " is not a power of 2";
+    }
+
+    gu::Lock lock(rings_mtx);
+    new_ring_size = size;
+}
+
+size_t
+gu::prof::Trace::ring_size()
+{
+    gu::Lock lock(rings_mtx);
+    return new_ring_size;
+}
+
+void
+gu::prof::Trace::enable(bool const val)
+{
+    gu_atomic_set(&enabled_, &val);
+}
+
+void
+gu::prof::Trace::record(const Key& key, bool const enter)
+{
+    pthread_once(&ring_key_once, create_ring_key);
+
+    Ring* ring(static_cast<Ring*>(pthread_getspecific(ring_key)));
+
+    if (gu_unlikely(NULL == ring)) ring = acquire_ring();
+
+    ring->push(key.file_, key.func_, key.line_, enter);
+}
+
+void
+gu::prof::Trace::dump(std::ostream& os)
+{
+    std::vector<Event> events;
+    {
+        gu::Lock lock(rings_mtx);
+
+        for (size_t i(0); i < rings.size(); ++i)
+        {
+            rings[i]->copy(events);
+        }
+    }
+
+    // stack of enter events to match leave events against, events of each
+    // ring are in order, so the stack is reset at ring and thread boundaries
+    std::vector<Event> open;
+    int thread(-1);
+
+    for (size_t i(0); i < events.size(); ++i)
+    {
+        const Event& e(events[i]);
+
+        if (e.thread_ != thread)
+        {
+            open.clear();
+            thread = e.thread_;
+        }
+
+        os << e.tstamp_ << ' ' << e.thread_ << ' '
+           << (e.enter_ ? "enter " : "leave ")
+           << e.file_ << ':' << e.func_ << ':' << e.line_;
+
+        if (e.enter_)
+        {
+            open.push_back(e);
+        }
+        else if (!open.empty() && open.back().line_ == e.line_ &&
+                 open.back().file_ == e.file_)
+        {
+            os << ' ' << (e.tstamp_ - open.back().tstamp_);
+            open.pop_back();
+        }
+
+        os << '\n';
+    }
+}
+
+void
+gu::prof::Trace::clear()
+{
+    gu::Lock lock(rings_mtx);
+
+    free_rings(keep_none);
+
+    for (size_t i(0); i < rings.size(); ++i) rings[i]->clear();
+}
@@ -12,6 +12,11 @@
  * can be inserted around the code and will be expanded to profiling 
  * code if GU_PROFILE is defined.
  *
+ * Regardless of GU_PROFILE, profile points also record timestamped enter and
+ * leave events into a per-thread ring buffer when tracing is switched on at
+ * runtime (see Trace below). With tracing off a profile point costs a single
+ * flag check.
+ *
  * Example usage:
  * @code
  *
@@ -47,6 +52,7 @@
 #include "gu_time.h"
 #include "gu_datetime.hpp"
 #include "gu_lock.hpp"
+#include "gu_macros.h"
 
 #if defined(HAVE_BOOST_UNORDERED_MAP_HPP)
 #include <boost/unordered_map.hpp>
@@ -59,6 +65,8 @@
 #endif // HAVE_BOOST_UNORDERED_MAP_HPP
 
 #include <ostream>
+#include <sstream>
+#include <iomanip>
 
 namespace gu
 {
@@ -68,6 +76,8 @@ namespace gu
         class KeyHash;
         class Point;
         class Profile;
+        class Trace;
+        class TracePoint;
         std::ostream& operator<<(std::ostream&, const Key&);
         std::ostream& operator<<(std::ostream&, const Profile&);
     }
@@ -111,25 +121,24 @@ private:
     friend class KeyHash;
     friend class Point;
     friend class Profile;
+    friend class Trace;
     friend std::ostream& operator<<(std::ostream& os, const Key&);
     const char* const file_;
     const char* const func_;
     const int         line_;
 };
 
-#ifdef HAVE_BOOST_UNORDERED_MAP_HPP
+// Key components are string literals, so pointer values identify them
 class gu::prof::KeyHash
 {
 public:
     size_t operator()(const Key& key) const
     {
-        return boost::hash_value(key.file_)
-            ^ boost::hash_value(key.func_)
-            ^ boost::hash_value(key.line_);
-
+        return reinterpret_cast<size_t>(key.file_)
+            ^ reinterpret_cast<size_t>(key.func_)
+            ^ static_cast<size_t>(key.line_);
     }
 };
-#endif // HAVE_BOOST_UNORDERED_MAP_HPP
 
 inline std::ostream& gu::prof::operator<<(std::ostream& os, 
                                           const gu::prof::Key& key)
@@ -138,6 +147,72 @@ inline std::ostream& gu::prof::operator<<(std::ostream& os,
 }
 
 
+/*!
+ * Runtime switchable tracing of profile points.
+ *
+ * Each thread records enter/leave events into its own ring buffer of
+ * ring_size() events, oldest events being overwritten. Recording takes no
+ * locks; rings are registered under a mutex only when a thread records
+ * its first event. Rings of exited threads keep their events for dump()
+ * and are reused by new threads, or freed by clear() and after ring size
+ * has changed.
+ */
+class gu::prof::Trace
+{
+public:
+
+    static size_t const DEFAULT_RING_SIZE = 1024;
+
+    /*! sets the number of events in rings allocated from now on,
+     *  must be a power of 2 */
+    static void set_ring_size(size_t size);
+
+    static size_t ring_size();
+
+    static bool enabled() { return enabled_; }
+
+    static void enable(bool val);
+
+    /*! records event in the calling thread's ring */
+    static void record(const Key& key, bool enter);
+
+    /*! writes events from all rings, one line per event:
+     *  <tstamp ns> <thread> enter|leave <file>:<func>:<line> [<duration ns>] */
+    static void dump(std::ostream& os);
+
+    /*! discards recorded events and frees rings of exited threads */
+    static void clear();
+
+private:
+
+    static bool enabled_;
+};
+
+/*!
+ * Records enter event on construction and leave event on destruction
+ * if tracing is enabled.
+ */
+class gu::prof::TracePoint
+{
+public:
+    TracePoint(const char* file, const char* func, int const line)
+        :
+        key_(file, func, line),
+        on_ (Trace::enabled())
+    {
+        if (gu_unlikely(on_)) Trace::record(key_, true);
+    }
+
+    ~TracePoint()
+    {
+        if (gu_unlikely(on_)) Trace::record(key_, false);
+    }
+
+private:
+    const Key  key_;
+    bool const on_;
+};
+
 class gu::prof::Point
 {
 public:
@@ -150,6 +225,7 @@ private:
     friend class Profile;
     const Profile& prof_;
     const Key key_;
+    const TracePoint trace_;
     mutable long long int enter_time_calendar_;
     mutable long long int enter_time_thread_cputime_;
 };
@@ -254,6 +330,7 @@ inline gu::prof::Point::Point(const Profile& prof,
                               const int line) :
     prof_(prof),
     key_(file, func, line),
+    trace_(file, func, line),
     enter_time_calendar_(),
     enter_time_thread_cputime_()
 {
@@ -313,7 +390,8 @@ inline std::ostream& gu::prof::operator<<(std::ostream& os, const Profile& prof)
 
 //
 // Convenience macros for defining profile entry and leave points.
-// If GU_PROFILE is undefined, these macros expand to no-op.
+// If GU_PROFILE is undefined, these macros expand to runtime trace points
+// only and profile statistics are not collected.
 //
 #ifdef GU_PROFILE
 #define profile_enter(__p)                                              \
@@ -321,11 +399,14 @@ inline std::ostream& gu::prof::operator<<(std::ostream& os, const Profile& prof)
     const gu::prof::Point __point((__p), __FILE__,                      \
                                   __FUNCTION__, __LINE__);              \
 
-#define profile_leave(__p)                      \
-    } while (0)
 #else
-#define profile_enter(__p)
-#define profile_leave(__p)
+#define profile_enter(__p)                                              \
+    do {                                                                \
+    const gu::prof::TracePoint __point(__FILE__, __FUNCTION__, __LINE__); \
+
 #endif // GU_PROFILE
 
+#define profile_leave(__p)                      \
+    } while (0)
+
 #endif // GU_PROFILE_HPP
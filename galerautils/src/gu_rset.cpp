@@ -62,6 +62,7 @@ check_size (RecordSet::CheckType const ct)
     case RecordSet::CHECK_MMH64:  return 8;
     case RecordSet::CHECK_MMH128: return 16;
 #define MAX_CHECKSUM_SIZE                16
+    case RecordSet::CHECK_CRC32C: return 4;
     }
 
     log_fatal << "Non-existing RecordSet::CheckType value: " << ct;
@@ -69,6 +70,21 @@ check_size (RecordSet::CheckType const ct)
 }
 
 
+void
+RecordSet::Check::gather (void* const buf, size_t const size) const
+{
+    if (CHECK_CRC32C == type_)
+    {
+        assert (size == sizeof(uint32_t));
+        *(static_cast<uint32_t*>(buf)) = htog<uint32_t>(crc_.get());
+    }
+    else
+    {
+        mmh_.gather (buf, size);
+    }
+}
+
+
 #define VER1_CRC_SIZE sizeof(uint32_t)
 
 static int
@@ -230,7 +246,8 @@ RecordSetOutBase::RecordSetOutBase (byte_t*                 reserved,
                                     size_t                  reserved_size,
                                     const BaseName&         base_name,
                                     CheckType const         ct,
-                                    Version const           version
+                                    Version const           version,
+                                    Allocator::PageCache*   cache
 #ifdef GU_RSET_CHECK_SIZE
                                     ,ssize_t const          max_size
 #endif
@@ -240,8 +257,10 @@ RecordSetOutBase::RecordSetOutBase (byte_t*                 reserved,
 #ifdef GU_RSET_CHECK_SIZE
     max_size_   (max_size),
 #endif
-    alloc_      (base_name, reserved, reserved_size),
-    check_      (),
+    alloc_      (base_name, reserved, reserved_size,
+                 Allocator::DEFAULT_MAX_HEAP, Allocator::DEFAULT_DISK_PAGE_SIZE,
+                 cache),
+    check_      (ct),
     bufs_       (),
     prev_stored_(true)
 {
@@ -286,6 +305,7 @@ ver1_check_type (const byte_t* buf, ssize_t const size)
     case RecordSet::CHECK_MMH32:  return RecordSet::CHECK_MMH32;
     case RecordSet::CHECK_MMH64:  return RecordSet::CHECK_MMH64;
     case RecordSet::CHECK_MMH128: return RecordSet::CHECK_MMH128;
+    case RecordSet::CHECK_CRC32C: return RecordSet::CHECK_CRC32C;
     }
 
     gu_throw_error (EPROTO) << "Unsupported RecordSet checksum type: " << ct;
@@ -376,14 +396,14 @@ RecordSetInBase::checksum() const
 
     if (cs > 0) /* checksum records */
     {
-        Hash check;
+        Check check(check_type_);
 
         check.append (head_ + begin_, size_ - begin_); /* records */
         check.append (head_, begin_ - cs);             /* header  */
 
         assert(cs <= MAX_CHECKSUM_SIZE);
         byte_t result[MAX_CHECKSUM_SIZE];
-        check.gather<sizeof(result)>(result);
+        check.gather (result, cs);
 
         const byte_t* const stored_checksum(head_ + begin_ - cs);
 
@@ -16,6 +16,7 @@
 #include "gu_vector.hpp"
 #include "gu_alloc.hpp"
 #include "gu_digest.hpp"
+#include "gu_crc.hpp"
 
 #ifdef GU_RSET_CHECK_SIZE
 #  include "gu_throw.hpp"
@@ -42,7 +43,8 @@ public:
         CHECK_NONE   = 0,
         CHECK_MMH32,
         CHECK_MMH64,
-        CHECK_MMH128
+        CHECK_MMH128,
+        CHECK_CRC32C  /* peers must understand it, see wire protocol version */
     };
 
     /*! return total size of a RecordSet */
@@ -55,6 +57,34 @@ public:
 
 protected:
 
+    /*! payload checksum calculator dispatching on CheckType */
+    class Check
+    {
+    public:
+
+        explicit Check (CheckType const ct = CHECK_NONE)
+            : mmh_(), crc_(), type_(ct) {}
+
+        void append (const void* const ptr, size_t const size)
+        {
+            switch (type_)
+            {
+            case CHECK_NONE:   break;
+            case CHECK_CRC32C: crc_.append(ptr, size); break;
+            default:           mmh_.append(ptr, size);
+            }
+        }
+
+        /*! writes size bytes of checksum in wire byte order to buf */
+        void gather (void* buf, size_t size) const;
+
+    private:
+
+        Hash      mmh_;
+        CRC32C    crc_;
+        CheckType type_;
+    };
+
     ssize_t   size_;
     int       count_;
 
@@ -103,7 +133,8 @@ protected:
                       const BaseName&   base_name,     /* basename for on-disk
                                                         * allocator */
                       CheckType         ct,
-                      Version           version  = MAX_VERSION
+                      Version           version  = MAX_VERSION,
+                      Allocator::PageCache* cache = NULL
 #ifdef GU_RSET_CHECK_SIZE
                       ,ssize_t          max_size = 0x7fffffff
 #endif
@@ -190,7 +221,7 @@ private:
 #endif
 
     Allocator     alloc_;
-    Hash          check_;
+    Check         check_;
     Vector<Buf, Allocator::INITIAL_VECTOR_SIZE> bufs_;
     bool          prev_stored_;
 
@@ -226,12 +257,14 @@ public:
                   size_t              reserved_size,
                   const BaseName&     base_name,
                   CheckType           ct,
-                  Version             version  = MAX_VERSION
+                  Version             version  = MAX_VERSION,
+                  Allocator::PageCache* cache  = NULL
 #ifdef GU_RSET_CHECK_SIZE
                   ,ssize_t            max_size = 0x7fffffff
 #endif
         )
-        : RecordSetOutBase (reserved, reserved_size, base_name, ct, version
+        : RecordSetOutBase (reserved, reserved_size, base_name, ct, version,
+                            cache
 #ifdef GU_RSET_CHECK_SIZE
                             ,max_size
 #endif
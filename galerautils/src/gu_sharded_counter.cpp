@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+#include "gu_sharded_counter.hpp"
+#include "gu_throw.hpp"
+#include "gu_macros.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <new>
+
+namespace
+{
+    // thread shard number + 1, 0 - not assigned yet
+    pthread_key_t  shard_key;
+    pthread_once_t shard_key_once = PTHREAD_ONCE_INIT;
+
+    extern "C" void create_shard_key()
+    {
+        pthread_key_create(&shard_key, NULL);
+    }
+}
+
+gu::ShardedCounter::Shard*
+gu::ShardedCounter::alloc_shards(long long const val)
+{
+    void* ptr;
+    int const err(posix_memalign(&ptr, CACHE_LINE, SHARDS * sizeof(Shard)));
+    if (err) gu_throw_error(err) << "Failed to allocate sharded counter";
+
+    Shard* const shards(static_cast<Shard*>(ptr));
+    for (int i(0); i < SHARDS; ++i) new (shards + i) Shard();
+    shards[0].val_ = val;
+
+    return shards;
+}
+
+gu::ShardedCounter::ShardedCounter(long long const val)
+    :
+    shards_(alloc_shards(val))
+{}
+
+gu::ShardedCounter::~ShardedCounter()
+{
+    for (int i(0); i < SHARDS; ++i) shards_[i].~Shard();
+    free(shards_);
+}
+
+int
+gu::ShardedCounter::shard()
+{
+    pthread_once(&shard_key_once, create_shard_key);
+
+    intptr_t s(reinterpret_cast<intptr_t>(pthread_getspecific(shard_key)));
+
+    if (gu_unlikely(0 == s))
+    {
+        // threads are assigned shards in round-robin fashion in the order
+        // of their first update, so that up to SHARDS threads never share
+        static gu::Atomic<int> next(0);
+
+        s = next.fetch_and_add(1) % SHARDS + 1;
+        pthread_setspecific(shard_key, reinterpret_cast<void*>(s));
+    }
+
+    return s - 1;
+}
@@ -0,0 +1,83 @@
+//
+// Copyright (C) 2016 Codership Oy <info@codership.com>
+//
+
+/*!
+ * @file Statistics counter sharded between threads.
+ *
+ * A single gu::Atomic updated from many threads makes its cache line bounce
+ * between cores on every increment. ShardedCounter spreads updates over
+ * SHARDS cache line sized slots, each thread sticking to its own slot, and
+ * sums the slots only when the value is read. It is meant for counters
+ * which are updated on hot paths but read rarely, like status variables.
+ *
+ * Updates remain atomic, so correctness does not depend on the number of
+ * threads, only the contention does.
+ */
+
+#ifndef GU_SHARDED_COUNTER_HPP
+#define GU_SHARDED_COUNTER_HPP
+
+#include "gu_atomic.hpp"
+
+namespace gu
+{
+    class ShardedCounter
+    {
+    public:
+
+        static int const SHARDS     = 16;
+        static int const CACHE_LINE = 64;
+
+        ShardedCounter(long long val = 0);
+
+        ~ShardedCounter();
+
+        /*! @return sum of all shards */
+        long long operator()() const
+        {
+            long long ret(0);
+            for (int i(0); i < SHARDS; ++i) ret += shards_[i].val_();
+            return ret;
+        }
+
+        /*! resets the counter, not atomic wrt. concurrent updates */
+        ShardedCounter& operator=(long long val)
+        {
+            for (int i(1); i < SHARDS; ++i) shards_[i].val_ = 0;
+            shards_[0].val_ = val;
+            return *this;
+        }
+
+        ShardedCounter& operator+=(long long val)
+        {
+            shards_[shard()].val_ += val;
+            return *this;
+        }
+
+        ShardedCounter& operator++() { return operator+=(1); }
+
+    private:
+
+        struct Shard
+        {
+            Shard() : val_(0) {}
+
+            gu::Atomic<long long> val_;
+            char pad_[CACHE_LINE - sizeof(gu::Atomic<long long>)];
+        };
+
+        static Shard* alloc_shards(long long val);
+
+        static int shard();
+
+        // shards are allocated at cache line boundary, as neither
+        // declarations nor new can guarantee such alignment in C++98
+        Shard* const shards_;
+
+        ShardedCounter(const ShardedCounter&);
+        ShardedCounter& operator=(const ShardedCounter&);
+    };
+}
+
+#endif // GU_SHARDED_COUNTER_HPP
@@ -82,10 +82,71 @@ START_TEST (basic)
 }
 END_TEST
 
+START_TEST (page_cache)
+{
+    gu::byte_t reserved[1 << 10];
+    TestBaseName test_name("gu_alloc_cache_test");
+    gu::Allocator::PageCache cache(1 << 20, 0);
+    gu::Allocator::PageCache::Stats stats;
+
+    bool n;
+    const gu::byte_t* first;
+
+    {
+        gu::Allocator a(test_name, reserved, sizeof(reserved),
+                        gu::Allocator::DEFAULT_MAX_HEAP,
+                        gu::Allocator::DEFAULT_DISK_PAGE_SIZE, &cache);
+
+        first = a.alloc(sizeof(reserved) * 2, n);
+        fail_if (0 == first);
+        fail_if (!n);
+    }
+
+    cache.get_stats(stats);
+    fail_if (stats.hits_   != 0);
+    fail_if (stats.misses_ != 1);
+    fail_if (stats.heap_   == 0);           /* page returned to cache */
+
+    {
+        gu::Allocator a(test_name, reserved, sizeof(reserved),
+                        gu::Allocator::DEFAULT_MAX_HEAP,
+                        gu::Allocator::DEFAULT_DISK_PAGE_SIZE, &cache);
+
+        const gu::byte_t* const p(a.alloc(sizeof(reserved) * 2, n));
+        fail_if (p != first);                /* same page reused */
+        fail_if (!n);
+
+        cache.get_stats(stats);
+        fail_if (stats.hits_ != 1);
+        fail_if (stats.heap_ != 0);
+    }
+
+    cache.set_limits(0, 0);                  /* frees cached pages */
+    cache.get_stats(stats);
+    fail_if (stats.heap_ != 0);
+
+    {
+        gu::Allocator a(test_name, reserved, sizeof(reserved),
+                        gu::Allocator::DEFAULT_MAX_HEAP,
+                        gu::Allocator::DEFAULT_DISK_PAGE_SIZE, &cache);
+        fail_if (0 == a.alloc(sizeof(reserved) * 2, n));
+    }
+
+    cache.get_stats(stats);
+    fail_if (stats.misses_ != 2);
+    fail_if (stats.heap_   != 0);           /* no room in cache */
+
+    cache.flush_stats();
+    cache.get_stats(stats);
+    fail_if (stats.hits_ != 0 || stats.misses_ != 0);
+}
+END_TEST
+
 Suite* gu_alloc_suite ()
 {
     TCase* t = tcase_create ("Allocator");
     tcase_add_test (t, basic);
+    tcase_add_test (t, page_cache);
 
     Suite* s = suite_create ("gu::Allocator");
     suite_add_tcase (s, t);
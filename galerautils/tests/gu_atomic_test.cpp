@@ -3,6 +3,7 @@
  */
 
 #include "../src/gu_atomic.hpp"
+#include "../src/gu_sharded_counter.hpp"
 
 #include "gu_atomic_test.hpp"
 
@@ -138,14 +139,68 @@ START_TEST(test_concurrency)
 }
 END_TEST
 
+START_TEST(test_sharded_counter)
+{
+    gu::ShardedCounter c(5);
+
+    fail_if(c() != 5);
+    ++c;  fail_if(c() != 6);
+    c += 4; fail_if(c() != 10);
+    c = 0; fail_if(c() != 0);
+    c += -3; fail_if(c() != -3);
+
+    // counters are members of heap allocated objects
+    gu::ShardedCounter* const h(new gu::ShardedCounter(-1));
+    ++(*h); fail_if((*h)() != 0);
+    delete h;
+}
+END_TEST
+
+static void* sharded_loop(void* arg)
+{
+    gu::ShardedCounter* const c(static_cast<gu::ShardedCounter*>(arg));
+
+    for (int i(iterations); --i;)
+    {
+        ++(*c);
+        *c += 2;
+    }
+
+    return NULL;
+}
+
+// more threads than shards, so that some of them have to share
+START_TEST(test_sharded_counter_concurrency)
+{
+    int const n(gu::ShardedCounter::SHARDS + 3);
+
+    gu::ShardedCounter c;
+    pthread_t          threads[n];
+
+    for (int i(0); i < n; ++i)
+    {
+        fail_if(pthread_create(&threads[i], NULL, sharded_loop, &c));
+    }
+
+    for (int i(0); i < n; ++i)
+    {
+        fail_if(pthread_join(threads[i], NULL));
+    }
+
+    fail_if(c() != 3LL * n * (iterations - 1), "%lld", c());
+}
+END_TEST
+
 Suite* gu_atomic_suite()
 {
     TCase* t1 = tcase_create ("sanity");
     tcase_add_test (t1, test_sanity_c);
     tcase_add_test (t1, test_sanity_cxx);
+    tcase_add_test (t1, test_sharded_counter);
 
     TCase* t2 = tcase_create ("concurrency");
     tcase_add_test (t2, test_concurrency);
+    tcase_add_test (t2, test_sharded_counter_concurrency);
     tcase_set_timeout(t2, 60);
 
     Suite* s = suite_create ("gu::Atomic");
@@ -4,7 +4,11 @@
 
 #include "../src/gu_histogram.hpp"
 #include "../src/gu_logger.hpp"
+#include "../src/gu_time.h"
 #include <cstdlib>
+#include <limits>
+#include <vector>
+#include <pthread.h>
 
 #include "gu_histogram_test.hpp"
 
@@ -31,10 +35,158 @@ START_TEST(test_histogram)
 }
 END_TEST
 
+START_TEST(test_log_histogram_buckets)
+{
+    /* buckets must be contiguous and values must map into their buckets */
+    fail_if(LogHistogram::bucket_low(0) != 0);
+
+    for (int b(1); b < LogHistogram::BUCKETS; ++b)
+    {
+        long long const low(LogHistogram::bucket_low(b));
+        long long const high(LogHistogram::bucket_high(b));
+
+        fail_if(low != LogHistogram::bucket_high(b - 1) + 1,
+                "bucket %d low: %lld, previous high: %lld",
+                b, low, LogHistogram::bucket_high(b - 1));
+        fail_if(LogHistogram::bucket(low)  != b, "bucket %d low", b);
+        fail_if(LogHistogram::bucket(high) != b, "bucket %d high", b);
+        /* relative error within 1/SUB_BUCKETS */
+        fail_if(double(high - low) > double(low) / LogHistogram::SUB_BUCKETS);
+    }
+
+    fail_if(LogHistogram::bucket_high(LogHistogram::BUCKETS - 1) !=
+            std::numeric_limits<long long>::max());
+}
+END_TEST
+
+START_TEST(test_log_histogram_percentiles)
+{
+    LogHistogram hs;
+    LogHistogram::Snapshot snap;
+
+    hs.snapshot(snap);
+    fail_if(snap.count() != 0);
+    fail_if(snap.percentile(0.5) != 0);
+
+    hs.insert(-1); // ignored
+
+    /* 990 x 10us, 9 x 1ms, 1 x 100ms */
+    for (int i(0); i < 990; ++i) hs.insert(10000);
+    for (int i(0); i < 9;   ++i) hs.insert(1000000);
+    hs.insert(100000000);
+
+    hs.snapshot(snap);
+    fail_if(snap.count() != 1000);
+    fail_if(snap.sum() != 990LL*10000 + 9LL*1000000 + 100000000);
+
+    long long const p50(snap.percentile(0.5));
+    long long const p99(snap.percentile(0.99));
+    long long const p999(snap.percentile(0.999));
+    long long const p100(snap.percentile(1.0));
+
+    fail_if(p50  < 10000     || p50  > 11250,     "p50: %lld",  p50);
+    fail_if(p99  != p50,                          "p99: %lld",  p99);
+    fail_if(p999 < 1000000   || p999 > 1125000,   "p999: %lld", p999);
+    fail_if(p100 < 100000000 || p100 > 112500000, "p100: %lld", p100);
+    fail_if(snap.min() > 10000 || snap.max() != p100);
+
+    /* small values are exact */
+    LogHistogram small;
+    for (int i(0); i < 16; ++i) small.insert(i);
+    LogHistogram::Snapshot snap_small;
+    small.snapshot(snap_small);
+    fail_if(snap_small.percentile(0.5) != 7);
+    fail_if(snap_small.max() != 15);
+
+    /* merge */
+    snap.merge(snap_small);
+    fail_if(snap.count() != 1016);
+    fail_if(snap.min() != 0);
+
+    hs.clear();
+    hs.snapshot(snap);
+    fail_if(snap.count() != 0 || snap.sum() != 0);
+}
+END_TEST
+
+static long long const LOG_HISTOGRAM_THREAD_INSERTS = 100000;
+
+static void* log_histogram_thread(void* arg)
+{
+    LogHistogram& hs(*static_cast<LogHistogram*>(arg));
+
+    for (long long i(0); i < LOG_HISTOGRAM_THREAD_INSERTS; ++i)
+    {
+        hs.insert(i);
+    }
+
+    return NULL;
+}
+
+START_TEST(test_log_histogram_concurrent)
+{
+    LogHistogram hs;
+
+    static int const n_threads(4);
+    pthread_t threads[n_threads];
+
+    for (int i(0); i < n_threads; ++i)
+    {
+        fail_if(pthread_create(&threads[i], NULL, log_histogram_thread, &hs));
+    }
+
+    for (int i(0); i < n_threads; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    LogHistogram::Snapshot snap;
+    hs.snapshot(snap);
+
+    fail_if(snap.count() != n_threads * LOG_HISTOGRAM_THREAD_INSERTS);
+    fail_if(snap.sum() != n_threads * LOG_HISTOGRAM_THREAD_INSERTS *
+            (LOG_HISTOGRAM_THREAD_INSERTS - 1) / 2);
+}
+END_TEST
+
+/* not a test as such, logs insert cost compared to gu::Histogram */
+START_TEST(test_log_histogram_insert_cost)
+{
+    static int const n(1 << 20);
+
+    std::vector<long long> vals(n);
+    for (int i(0); i < n; ++i) vals[i] = ::rand() % 100000000; // up to 100ms
+
+    Histogram hs("0.0,0.0001,0.00031623,0.001,0.0031623,0.01,0.031623,0.1,"
+                 "0.31623,1.,3.1623,10.,31.623");
+
+    long long start(gu_time_monotonic());
+    for (int i(0); i < n; ++i) hs.insert(vals[i] * 1.0e-9);
+    double const hs_cost(double(gu_time_monotonic() - start) / n);
+
+    LogHistogram lhs;
+
+    start = gu_time_monotonic();
+    for (int i(0); i < n; ++i) lhs.insert(vals[i]);
+    double const lhs_cost(double(gu_time_monotonic() - start) / n);
+
+    LogHistogram::Snapshot snap;
+    lhs.snapshot(snap);
+    fail_if(snap.count() != n);
+
+    log_info << "Histogram insert: " << hs_cost << " ns, LogHistogram insert: "
+             << lhs_cost << " ns";
+}
+END_TEST
+
 Suite* gu_histogram_suite()
 {
     TCase* t = tcase_create ("test_histogram");
     tcase_add_test (t, test_histogram);
+    tcase_add_test (t, test_log_histogram_buckets);
+    tcase_add_test (t, test_log_histogram_percentiles);
+    tcase_add_test (t, test_log_histogram_concurrent);
+    tcase_add_test (t, test_log_histogram_insert_cost);
 
     Suite* s = suite_create ("gu::Histogram");
     suite_add_tcase (s, t);
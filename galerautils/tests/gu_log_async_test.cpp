@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2016 Codership Oy <info@codership.com>
+ */
+
+#include "../src/gu_log_async.hpp"
+#include "../src/gu_logger.hpp"
+#include "../src/gu_atomic.hpp"
+
+#include "gu_log_async_test.hpp"
+
+#include <pthread.h>
+#include <cstring>
+
+static gu::Atomic<long long> logged(0);
+static gu::Atomic<long long> in_thread(0);
+static pthread_t             test_thread;
+
+static gu::Atomic<long long> before_fatal(-1);
+
+static void count_cb(int severity, const char* msg)
+{
+    if (strstr(msg, "async test message"))
+    {
+        if (GU_LOG_FATAL == severity) before_fatal = logged();
+        ++logged;
+        if (!pthread_equal(pthread_self(), test_thread)) ++in_thread;
+    }
+}
+
+START_TEST(test_log_async)
+{
+    test_thread = pthread_self();
+
+    gu_conf_set_log_callback(count_cb);
+
+    gu::AsyncLog::start();
+    fail_unless(gu::AsyncLog::started());
+    gu::AsyncLog::start(); // second start is a no-op
+
+    long long const n(gu::AsyncLog::QUEUE_SIZE * 4);
+
+    for (long long i(0); i < n; ++i)
+    {
+        log_info << "async test message " << i;
+    }
+
+    gu::AsyncLog::stop();
+    fail_if(gu::AsyncLog::started());
+
+    // all messages were written, either by writer thread or synchronously
+    // on queue overflow
+    fail_if(logged() != n, "logged %lld out of %lld", logged(), n);
+    fail_if(in_thread() + gu::AsyncLog::overflows() != n,
+            "in thread: %lld, overflows: %lld",
+            in_thread(), gu::AsyncLog::overflows());
+    fail_if(in_thread() == 0);
+
+    // after stop messages are written synchronously again
+    log_info << "async test message after stop";
+    fail_if(logged() != n + 1);
+
+    gu_conf_set_log_callback(NULL);
+}
+END_TEST
+
+START_TEST(test_log_async_sync)
+{
+    test_thread = pthread_self();
+    logged = 0;
+
+    gu_conf_set_log_callback(count_cb);
+
+    gu::AsyncLog::start();
+
+    long long const n(gu::AsyncLog::QUEUE_SIZE / 2);
+
+    for (long long i(0); i < n; ++i)
+    {
+        log_info << "async test message " << i;
+    }
+
+    // fatal message is written after everything queued before it
+    log_fatal << "async test message fatal";
+    fail_if(before_fatal() != n, "before fatal %lld out of %lld",
+            before_fatal(), n);
+    fail_if(logged() != n + 1);
+
+    // a thread which picked up the sink before stop() must not leave
+    // its message in the queue
+    gu_log_cb_t const sink(gu_log_sink);
+    gu::AsyncLog::stop();
+    sink(GU_LOG_INFO, "async test message late");
+    fail_if(logged() != n + 2);
+
+    gu_conf_set_log_callback(NULL);
+}
+END_TEST
+
+Suite* gu_log_async_suite()
+{
+    TCase* t = tcase_create ("gu_log_async");
+    tcase_add_test (t, test_log_async);
+    tcase_add_test (t, test_log_async_sync);
+
+    Suite* s = suite_create ("gu::AsyncLog");
+    suite_add_tcase (s, t);
+
+    return s;
+}
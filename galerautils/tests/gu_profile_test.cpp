@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2016 Codership Oy <info@codership.com>
+ */
+
+#include "../src/gu_profile.hpp"
+#include "../src/gu_exception.hpp"
+
+#include "gu_profile_test.hpp"
+
+#include <pthread.h>
+#include <sstream>
+#include <string>
+
+static gu::prof::Profile prof("test");
+
+static void profiled()
+{
+    profile_enter(prof);
+    profile_leave(prof);
+}
+
+static void* profiled_loop(void* arg)
+{
+    long const n(reinterpret_cast<long>(arg));
+    for (long i(0); i < n; ++i) profiled();
+    return NULL;
+}
+
+static size_t count(const std::string& str, const std::string& what)
+{
+    size_t ret(0);
+    for (size_t pos(str.find(what)); pos != std::string::npos;
+         pos = str.find(what, pos + 1)) ++ret;
+    return ret;
+}
+
+START_TEST(test_trace)
+{
+    gu::prof::Trace::clear();
+
+    profiled(); // disabled, nothing should be recorded
+
+    gu::prof::Trace::enable(true);
+    fail_unless(gu::prof::Trace::enabled());
+
+    profiled();
+
+    pthread_t thd;
+    fail_if(pthread_create(&thd, NULL, profiled_loop,
+                           reinterpret_cast<void*>(2L)));
+    fail_if(pthread_join(thd, NULL));
+
+    gu::prof::Trace::enable(false);
+    profiled();
+
+    std::ostringstream os;
+    gu::prof::Trace::dump(os);
+    std::string const str(os.str());
+
+    fail_if(count(str, "\n") != 6, "dump:\n%s", str.c_str());
+    fail_if(count(str, " enter ") != 3, "dump:\n%s", str.c_str());
+    fail_if(count(str, " leave ") != 3, "dump:\n%s", str.c_str());
+    fail_if(count(str, "profiled") != 6, "dump:\n%s", str.c_str());
+
+    gu::prof::Trace::clear();
+    std::ostringstream os2;
+    gu::prof::Trace::dump(os2);
+    fail_if(os2.str().size() != 0, "dump after clear:\n%s", os2.str().c_str());
+}
+END_TEST
+
+START_TEST(test_trace_ring_overflow)
+{
+    gu::prof::Trace::clear();
+    gu::prof::Trace::enable(true);
+
+    pthread_t thd;
+    long const n(gu::prof::Trace::ring_size()); // 2 * ring_size() events
+    fail_if(pthread_create(&thd, NULL, profiled_loop,
+                           reinterpret_cast<void*>(n)));
+    fail_if(pthread_join(thd, NULL));
+
+    gu::prof::Trace::enable(false);
+
+    std::ostringstream os;
+    gu::prof::Trace::dump(os);
+
+    // only the last ring_size() events are kept, the oldest of them is
+    // discarded as it could be overwritten by the next push
+    fail_if(count(os.str(), "\n") != gu::prof::Trace::ring_size() - 1,
+            "%zu lines", count(os.str(), "\n"));
+
+    gu::prof::Trace::clear();
+}
+END_TEST
+
+START_TEST(test_trace_ring_size)
+{
+    try
+    {
+        gu::prof::Trace::set_ring_size(1000);
+        fail("ring size which is not a power of 2 accepted");
+    }
+    catch (gu::Exception& e)
+    {
+        fail_if(e.get_errno() != EINVAL);
+    }
+
+    gu::prof::Trace::set_ring_size(16);
+    gu::prof::Trace::clear();
+    gu::prof::Trace::enable(true);
+
+    pthread_t thd;
+    fail_if(pthread_create(&thd, NULL, profiled_loop,
+                           reinterpret_cast<void*>(100L)));
+    fail_if(pthread_join(thd, NULL));
+
+    gu::prof::Trace::enable(false);
+
+    std::ostringstream os;
+    gu::prof::Trace::dump(os);
+    fail_if(count(os.str(), "\n") != 15, "%zu lines", count(os.str(), "\n"));
+
+    gu::prof::Trace::set_ring_size(gu::prof::Trace::DEFAULT_RING_SIZE);
+    gu::prof::Trace::clear();
+}
+END_TEST
+
+Suite* gu_profile_suite()
+{
+    TCase* t = tcase_create ("gu_profile");
+    tcase_add_test (t, test_trace);
+    tcase_add_test (t, test_trace_ring_overflow);
+    tcase_add_test (t, test_trace_ring_size);
+
+    Suite* s = suite_create ("gu::prof");
+    suite_add_tcase (s, t);
+
+    return s;
+}
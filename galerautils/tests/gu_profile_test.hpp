@@ -0,0 +1,12 @@
+/*
+ * Copyright (C) 2016 Codership Oy <info@codership.com>
+ */
+
+#ifndef __gu_profile_test__
+#define __gu_profile_test__
+
+#include <check.h>
+
+extern Suite *gu_profile_suite(void);
+
+#endif // __gu_profile_test__
@@ -366,6 +366,63 @@ START_TEST (ver0)
 }
 END_TEST
 
+START_TEST (ver1_crc32c)
+{
+    TestRecord rout0(64,  "abc0");
+    TestRecord rout1(250, "abc1");
+
+    gu::byte_t reserved[1024];
+    TestBaseName str("gu_rset_test");
+    gu::RecordSetOut<TestRecord> rset_out(reserved, sizeof(reserved), str,
+                                          gu::RecordSet::CHECK_CRC32C,
+                                          gu::RecordSet::VER1);
+
+    rset_out.append (rout0);
+    rset_out.append (rout1.buf(), rout1.serial_size(), false);
+
+    gu::RecordSet::GatherVector out_bufs;
+    size_t const out_size (rset_out.gather (out_bufs));
+
+    std::vector<gu::byte_t> in_buf;
+    in_buf.reserve(out_size);
+    for (size_t i = 0; i < out_bufs->size(); ++i)
+    {
+        const gu::byte_t* const begin
+            (reinterpret_cast<const gu::byte_t*>(out_bufs[i].ptr));
+
+        in_buf.insert (in_buf.end(), begin, begin + out_bufs[i].size);
+    }
+
+    fail_if (in_buf.size() != out_size);
+
+    gu::RecordSetIn<TestRecord> const rset_in(in_buf.data(), in_buf.size());
+
+    fail_if (rset_in.count() != 2);
+    fail_if (rset_in.next() != rout0);
+    fail_if (rset_in.next() != rout1);
+
+    try {
+        rset_in.checksum();
+    }
+    catch (std::exception& e)
+    {
+        fail("%s", e.what());
+    }
+
+    /* corrupt last payload byte */
+    in_buf[in_buf.size() - 1] ^= 1;
+
+    try {
+        rset_in.checksum();
+        fail("checksum() didn't throw on corrupted set");
+    }
+    catch (gu::Exception& e)
+    {
+        fail_if (e.get_errno() != EINVAL);
+    }
+}
+END_TEST
+
 START_TEST (empty)
 {
     gu::RecordSetIn<TestRecord> const rset_in(0, 0);
@@ -387,6 +444,7 @@ Suite* gu_rset_suite ()
 {
     TCase* t = tcase_create ("RecordSet");
     tcase_add_test (t, ver0);
+    tcase_add_test (t, ver1_crc32c);
     tcase_add_test (t, empty);
     tcase_set_timeout(t, 60);
 
@@ -26,6 +26,8 @@
 #include "gu_histogram_test.hpp"
 #include "gu_stats_test.hpp"
 #include "gu_thread_test.hpp"
+#include "gu_log_async_test.hpp"
+#include "gu_profile_test.hpp"
 
 typedef Suite *(*suite_creator_t)(void);
 
@@ -47,6 +49,8 @@ static suite_creator_t suites[] =
     gu_histogram_suite,
     gu_stats_suite,
     gu_thread_suite,
+    gu_log_async_suite,
+    gu_profile_suite,
     0
 };
 
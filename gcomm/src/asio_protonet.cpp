@@ -11,6 +11,7 @@
 
 #include "gcomm/util.hpp"
 #include "gcomm/conf.hpp"
+#include "defaults.hpp"
 
 #include "gu_logger.hpp"
 
@@ -34,7 +35,13 @@ gcomm::AsioProtonet::AsioProtonet(gu::Config& conf, int version)
     mtu_(1 << 15),
     checksum_(NetHeader::checksum_type(
                   conf.get<int>(gcomm::Conf::SocketChecksum,
-                                NetHeader::CS_CRC32C)))
+                                NetHeader::CS_CRC32C))),
+    io_pool_(),
+    io_work_(0),
+    io_threads_(),
+    io_mutex_(),
+    io_errno_(0),
+    io_error_()
 {
     conf.set(gcomm::Conf::SocketChecksum, checksum_);
 #ifdef HAVE_ASIO_SSL_HPP
@@ -55,11 +62,101 @@ gcomm::AsioProtonet::AsioProtonet(gu::Config& conf, int version)
         gu::ssl_prepare_context(conf_, ssl_context_);
     }
 #endif // HAVE_ASIO_SSL_HPP
+
+    int const io_threads(check_range<int>(
+                             Conf::SocketIoThreads,
+                             conf.get(Conf::SocketIoThreads,
+                                      Defaults::SocketIoThreads),
+                             0, 64));
+
+    if (io_threads > 0)
+    {
+        io_work_ = new asio::io_service::work(io_pool_);
+
+        for (int i(0); i < io_threads; ++i)
+        {
+            gu_thread_t thd;
+            int const err(gu_thread_create(&thd, NULL, io_thd_func, this));
+
+            if (err != 0)
+            {
+                log_warn << "Failed to start socket I/O thread: " << err
+                         << " (" << ::strerror(err) << ")";
+                break;
+            }
+
+            io_threads_.push_back(thd);
+        }
+
+        log_info << "started " << io_threads_.size() << " socket I/O threads";
+
+        if (io_threads_.empty())
+        {
+            delete io_work_;
+            io_work_ = 0;
+        }
+    }
 }
 
 gcomm::AsioProtonet::~AsioProtonet()
 {
+    if (io_work_ != 0)
+    {
+        delete io_work_;
+        io_pool_.stop();
+
+        for (size_t i(0); i < io_threads_.size(); ++i)
+        {
+            gu_thread_join(io_threads_[i], NULL);
+        }
+    }
+}
 
+void* gcomm::AsioProtonet::io_thd_func(void* arg)
+{
+    static_cast<AsioProtonet*>(arg)->run_io_pool();
+    return 0;
+}
+
+void gcomm::AsioProtonet::run_io_pool()
+{
+    while (true)
+    {
+        try
+        {
+            io_pool_.run();
+            break;
+        }
+        catch (gu::Exception& e)
+        {
+            io_pool_error(e.get_errno(), e.what());
+        }
+        catch (asio::system_error& e)
+        {
+            io_pool_error(e.code().value(), e.what());
+        }
+        catch (std::exception& e)
+        {
+            io_pool_error(EPROTO, e.what());
+        }
+        catch (...)
+        {
+            io_pool_error(EPROTO, "unknown exception");
+        }
+    }
+}
+
+// forwards error to the gcomm thread which owns error handling,
+// see event_loop()
+void gcomm::AsioProtonet::io_pool_error(int const err, const char* const what)
+{
+    gu::Lock lock(io_mutex_);
+    if (io_errno_ == 0)
+    {
+        io_errno_ = err != 0 ? err : EPROTO;
+        io_error_ = what;
+    }
+    io_service_.stop();
 }
 
 void gcomm::AsioProtonet::enter()
@@ -119,6 +216,15 @@ void gcomm::AsioProtonet::event_loop(const gu::datetime::Period& period)
     timer_.async_wait(boost::bind(&AsioProtonet::handle_wait, this,
                                   asio::placeholders::error));
     io_service_.run();
+
+    if (gu_unlikely(io_pool()))
+    {
+        gu::Lock lock(io_mutex_);
+        if (io_errno_ != 0)
+        {
+            gu_throw_error(io_errno_) << "socket I/O thread: " << io_error_;
+        }
+    }
 }
 
 
@@ -10,6 +10,7 @@
 
 #include "gu_monitor.hpp"
 #include "gu_asio.hpp"
+#include "gu_thread.hpp"
 
 #include <vector>
 #include <deque>
@@ -37,6 +38,14 @@ public:
     void leave();
     size_t mtu() const { return mtu_; }
 
+    // io_service to run TCP socket I/O on
+    asio::io_service& socket_service()
+    {
+        return (io_threads_.empty() ? io_service_ : io_pool_);
+    }
+
+    bool io_pool() const { return !io_threads_.empty(); }
+
 #ifdef HAVE_ASIO_SSL_HPP
     std::string get_ssl_password() const;
 #endif // HAVE_ASIO_SSL_HPP
@@ -47,9 +56,14 @@ private:
     friend class AsioTcpAcceptor;
     friend class AsioUdpSocket;
     AsioProtonet(const AsioProtonet&);
+    AsioProtonet& operator=(const AsioProtonet&);
 
     void handle_wait(const asio::error_code& ec);
 
+    static void* io_thd_func(void* arg);
+    void run_io_pool();
+    void io_pool_error(int err, const char* what);
+
     gu::RecursiveMutex          mutex_;
     gu::datetime::Date          poll_until_;
     asio::io_service            io_service_;
@@ -60,6 +74,14 @@ private:
     size_t                      mtu_;
 
     NetHeader::checksum_t       checksum_;
+
+    // socket I/O thread pool, see Conf::SocketIoThreads
+    asio::io_service            io_pool_;
+    asio::io_service::work*     io_work_;
+    std::vector<gu_thread_t>    io_threads_;
+    gu::Mutex                   io_mutex_;
+    int                         io_errno_; // error raised in I/O thread
+    std::string                 io_error_;
 };
 
 #endif // GCOMM_ASIO_PROTONET_HPP
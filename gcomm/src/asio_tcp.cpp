@@ -6,6 +6,10 @@
 #include "gcomm/util.hpp"
 #include "gcomm/common.hpp"
 
+#if defined(__linux__)
+#include <netinet/tcp.h>
+#endif /* __linux__ */
+
 
 #define FAILED_HANDLER(_e) failed_handler(_e, __FUNCTION__, __LINE__)
 
@@ -13,13 +17,18 @@ gcomm::AsioTcpSocket::AsioTcpSocket(AsioProtonet& net, const gu::URI& uri)
     :
     Socket       (uri),
     net_         (net),
-    socket_      (net.io_service_),
+    socket_      (net.socket_service()),
 #ifdef HAVE_ASIO_SSL_HPP
     ssl_socket_  (0),
 #endif /* HAVE_ASIO_SSL_HPP */
+    strand_      (net.socket_service()),
     send_q_      (),
+    send_q_bytes_(0),
+    tx_bytes_    (0),
+    rx_bytes_    (0),
     recv_buf_    (net_.mtu() + NetHeader::serial_size_),
     recv_offset_ (0),
+    recv_dgs_    (),
     state_       (S_CLOSED),
     local_addr_  (),
     remote_addr_ ()
@@ -68,6 +77,8 @@ void gcomm::AsioTcpSocket::failed_handler(const asio::error_code& ec,
 #ifdef HAVE_ASIO_SSL_HPP
 void gcomm::AsioTcpSocket::handshake_handler(const asio::error_code& ec)
 {
+    Critical<AsioProtonet> crit(net_);
+
     if (ec)
     {
         if (ec.category() == asio::error::get_ssl_category() &&
@@ -128,9 +139,10 @@ void gcomm::AsioTcpSocket::connect_handler(const asio::error_code& ec)
                           << local_addr();
                 ssl_socket_->async_handshake(
                     asio::ssl::stream<asio::ip::tcp::socket>::client,
-                    boost::bind(&AsioTcpSocket::handshake_handler,
-                                shared_from_this(),
-                                asio::placeholders::error)
+                    strand_.wrap(
+                        boost::bind(&AsioTcpSocket::handshake_handler,
+                                    shared_from_this(),
+                                    asio::placeholders::error))
                     );
             }
             else
@@ -173,13 +185,14 @@ void gcomm::AsioTcpSocket::connect(const gu::URI& uri)
         if (uri.get_scheme() == gu::scheme::ssl)
         {
             ssl_socket_ = new asio::ssl::stream<asio::ip::tcp::socket>(
-                net_.io_service_, net_.ssl_context_
+                net_.socket_service(), net_.ssl_context_
             );
 
             ssl_socket_->lowest_layer().async_connect(
-                *i, boost::bind(&AsioTcpSocket::connect_handler,
+                *i, strand_.wrap(
+                    boost::bind(&AsioTcpSocket::connect_handler,
                                 shared_from_this(),
-                                asio::placeholders::error)
+                                asio::placeholders::error))
             );
         }
         else
@@ -194,9 +207,10 @@ void gcomm::AsioTcpSocket::connect(const gu::URI& uri)
                     0);
                 socket_.bind(ep);
             }
-            socket_.async_connect(*i, boost::bind(&AsioTcpSocket::connect_handler,
+            socket_.async_connect(*i, strand_.wrap(
+                                      boost::bind(&AsioTcpSocket::connect_handler,
                                                   shared_from_this(),
-                                                  asio::placeholders::error));
+                                                  asio::placeholders::error)));
 #ifdef HAVE_ASIO_SSL_HPP
         }
 #endif /* HAVE_ASIO_SSL_HPP */
@@ -222,7 +236,16 @@ void gcomm::AsioTcpSocket::close()
 
     if (send_q_.empty() == true || state() != S_CONNECTED)
     {
-        close_socket();
+        if (net_.io_pool())
+        {
+            // socket operations may be in progress in I/O thread
+            strand_.post(boost::bind(&AsioTcpSocket::close_socket,
+                                     shared_from_this()));
+        }
+        else
+        {
+            close_socket();
+        }
         state_ = S_CLOSED;
     }
     else
@@ -262,6 +285,7 @@ void gcomm::AsioTcpSocket::write_handler(const asio::error_code& ec,
         {
             const Datagram& dg(send_q_.front());
             bytes_transferred -= dg.len();
+            send_q_bytes_ -= dg.len();
             send_q_.pop_front();
         }
         gcomm_assert(bytes_transferred == 0);
@@ -273,8 +297,10 @@ void gcomm::AsioTcpSocket::write_handler(const asio::error_code& ec,
             cbs[0] = asio::const_buffer(dg.header()
                                         + dg.header_offset(),
                                         dg.header_len());
-            cbs[1] = asio::const_buffer(&dg.payload()[0],
-                                        dg.payload().size());
+            cbs[1] = asio::const_buffer(&dg.payload()[0]
+                                        + dg.payload_offset(),
+                                        dg.payload().size()
+                                        - dg.payload_offset());
             write_one(cbs);
         }
         else if (state_ == S_CLOSING)
@@ -323,6 +349,8 @@ namespace gcomm
         { }
         void operator()()
         {
+            Critical<AsioProtonet> crit(socket_->net_);
+
             if (socket_->state() == gcomm::Socket::S_CONNECTED &&
                 socket_->send_q_.empty() == false)
             {
@@ -331,8 +359,10 @@ namespace gcomm
                 cbs[0] = asio::const_buffer(dg.header()
                                             + dg.header_offset(),
                                             dg.header_len());
-                cbs[1] = asio::const_buffer(&dg.payload()[0],
-                                            dg.payload().size());
+                cbs[1] = asio::const_buffer(&dg.payload()[0]
+                                            + dg.payload_offset(),
+                                            dg.payload().size()
+                                            - dg.payload_offset());
                 socket_->write_one(cbs);
             }
         }
@@ -366,10 +396,12 @@ int gcomm::AsioTcpSocket::send(const Datagram& dg)
               priv_dg.header(),
               priv_dg.header_size(),
               priv_dg.header_offset());
+    send_q_bytes_ += priv_dg.len();
+    tx_bytes_     += priv_dg.len();
 
     if (send_q_.size() == 1)
     {
-        net_.io_service_.post(AsioPostForSendHandler(shared_from_this()));
+        strand_.post(AsioPostForSendHandler(shared_from_this()));
     }
     return 0;
 }
@@ -378,10 +410,9 @@ int gcomm::AsioTcpSocket::send(const Datagram& dg)
 void gcomm::AsioTcpSocket::read_handler(const asio::error_code& ec,
                                         const size_t bytes_transferred)
 {
-    Critical<AsioProtonet> crit(net_);
-
     if (ec)
     {
+        Critical<AsioProtonet> crit(net_);
 #ifdef HAVE_ASIO_SSL_HPP
         if (ec.category() == asio::error::get_ssl_category() &&
             gu::exclude_ssl_error(ec) == false)
@@ -394,74 +425,123 @@ void gcomm::AsioTcpSocket::read_handler(const asio::error_code& ec,
         return;
     }
 
-    if (state() != S_CONNECTED && state() != S_CLOSING)
-    {
-        log_debug << "read handler for " << id()
-                  << " state " << state();
-        return;
-    }
-
     recv_offset_ += bytes_transferred;
 
-    while (recv_offset_ >= NetHeader::serial_size_)
+    // Split and verify all complete messages in place before entering
+    // critical section, so that with socket I/O threads this is done
+    // concurrently for different sockets. The unconsumed tail is moved
+    // to the beginning of the buffer only once per read.
+    int    err(0);
+    size_t parsed(0);
+    size_t pending(0); // size of incomplete message at the end of buffer
+
+    recv_dgs_.clear();
+
+    while (recv_offset_ - parsed >= NetHeader::serial_size_)
     {
+        const gu::byte_t* const msg(&recv_buf_[0] + parsed);
         NetHeader hdr;
         try
         {
-            unserialize(&recv_buf_[0], recv_buf_.size(), 0, hdr);
+            unserialize(msg, recv_offset_ - parsed, 0, hdr);
         }
         catch (gu::Exception& e)
         {
-            FAILED_HANDLER(asio::error_code(e.get_errno(),
-                                            asio::error::system_category));
-            return;
+            err = e.get_errno();
+            break;
         }
-        if (recv_offset_ >= hdr.len() + NetHeader::serial_size_)
+
+        const size_t msg_size(NetHeader::serial_size_ + hdr.len());
+
+        if (recv_offset_ - parsed < msg_size)
         {
-            Datagram dg(
-                gu::SharedBuffer(
-                    new gu::Buffer(&recv_buf_[0] + NetHeader::serial_size_,
-                                   &recv_buf_[0] + NetHeader::serial_size_
-                                   + hdr.len())));
-            if (net_.checksum_ != NetHeader::CS_NONE)
-            {
-#ifdef TEST_NET_CHECKSUM_ERROR
-                long rnd(rand());
-                if (rnd % 10000 == 0)
-                {
-                    hdr.set_crc32(net_.checksum_, static_cast<uint32_t>(rnd));
-                }
-#endif /* TEST_NET_CHECKSUM_ERROR */
+            pending = msg_size;
+            break;
+        }
 
-                if (check_cs (hdr, dg))
-                {
-                    log_warn << "checksum failed, hdr: len=" << hdr.len()
-                             << " has_crc32="  << hdr.has_crc32()
-                             << " has_crc32c=" << hdr.has_crc32c()
-                             << " crc32=" << hdr.crc32();
-                    FAILED_HANDLER(asio::error_code(
-                                       EPROTO,
-                                       asio::error::system_category));
-                    return;
-                }
+        if (recv_buf_.size() == msg_size && recv_offset_ == msg_size)
+        {
+            // Buffer was enlarged to fit exactly this message, hand it
+            // over to the datagram instead of copying large payload.
+            gu::SharedBuffer buf(new gu::Buffer());
+            buf->swap(recv_buf_);
+            recv_buf_.resize(net_.mtu() + NetHeader::serial_size_);
+            recv_dgs_.push_back(Datagram(buf, NetHeader::serial_size_));
+        }
+        else
+        {
+            recv_dgs_.push_back(
+                Datagram(
+                    gu::SharedBuffer(
+                        new gu::Buffer(msg + NetHeader::serial_size_,
+                                       msg + msg_size))));
+        }
+        if (net_.checksum_ != NetHeader::CS_NONE)
+        {
+#ifdef TEST_NET_CHECKSUM_ERROR
+            long rnd(rand());
+            if (rnd % 10000 == 0)
+            {
+                hdr.set_crc32(net_.checksum_, static_cast<uint32_t>(rnd));
             }
-            ProtoUpMeta um;
-            net_.dispatch(id(), dg, um);
-            recv_offset_ -= NetHeader::serial_size_ + hdr.len();
+#endif /* TEST_NET_CHECKSUM_ERROR */
 
-            if (recv_offset_ > 0)
+            if (check_cs (hdr, recv_dgs_.back()))
             {
-                memmove(&recv_buf_[0],
-                        &recv_buf_[0] + NetHeader::serial_size_ + hdr.len(),
-                        recv_offset_);
+                log_warn << "checksum failed, hdr: len=" << hdr.len()
+                         << " has_crc32="  << hdr.has_crc32()
+                         << " has_crc32c=" << hdr.has_crc32c()
+                         << " crc32=" << hdr.crc32();
+                recv_dgs_.pop_back();
+                err = EPROTO;
+                break;
             }
         }
-        else
+        parsed += msg_size;
+    }
+
+    if (parsed > 0)
+    {
+        recv_offset_ -= parsed;
+
+        if (recv_offset_ > 0)
         {
-            break;
+            memmove(&recv_buf_[0], &recv_buf_[0] + parsed, recv_offset_);
         }
     }
 
+    if (pending > recv_buf_.size())
+    {
+        // Message larger than network MTU, sent by a peer with larger
+        // gmcast.max_message_size. Grow the buffer to fit it exactly.
+        recv_buf_.resize(pending);
+    }
+
+    Critical<AsioProtonet> crit(net_);
+
+    if (state() != S_CONNECTED && state() != S_CLOSING)
+    {
+        log_debug << "read handler for " << id()
+                  << " state " << state();
+        return;
+    }
+
+    for (std::vector<Datagram>::const_iterator i(recv_dgs_.begin());
+         i != recv_dgs_.end(); ++i)
+    {
+        ProtoUpMeta um;
+        rx_bytes_ += i->len() - i->offset() + NetHeader::serial_size_;
+        net_.dispatch(id(), *i, um);
+    }
+
+    recv_dgs_.clear();
+
+    if (err != 0)
+    {
+        FAILED_HANDLER(asio::error_code(err, asio::error::system_category));
+        return;
+    }
+
     boost::array<asio::mutable_buffer, 1> mbs;
     mbs[0] = asio::mutable_buffer(&recv_buf_[0] + recv_offset_,
                                   recv_buf_.size() - recv_offset_);
@@ -472,9 +552,12 @@ size_t gcomm::AsioTcpSocket::read_completion_condition(
     const asio::error_code& ec,
     const size_t bytes_transferred)
 {
-    Critical<AsioProtonet> crit(net_);
+    // Called in socket strand like read_handler(), so receive buffer can be
+    // examined without protonet lock. It is needed only to fail the socket,
+    // state is checked in read_handler() once the read completes.
     if (ec)
     {
+        Critical<AsioProtonet> crit(net_);
 #ifdef HAVE_ASIO_SSL_HPP
         if (ec.category() == asio::error::get_ssl_category() &&
             gu::exclude_ssl_error(ec) == false)
@@ -487,13 +570,6 @@ size_t gcomm::AsioTcpSocket::read_completion_condition(
         return 0;
     }
 
-    if (state() != S_CONNECTED && state() != S_CLOSING)
-    {
-        log_debug << "read completion condition for " << id()
-                  << " state " << state();
-        return 0;
-    }
-
     if (recv_offset_ + bytes_transferred >= NetHeader::serial_size_)
     {
         NetHeader hdr;
@@ -503,6 +579,7 @@ size_t gcomm::AsioTcpSocket::read_completion_condition(
         }
         catch (gu::Exception& e)
         {
+            Critical<AsioProtonet> crit(net_);
             log_warn << "unserialize error " << e.what();
             FAILED_HANDLER(asio::error_code(e.get_errno(),
                                             asio::error::system_category));
@@ -535,6 +612,30 @@ size_t gcomm::AsioTcpSocket::mtu() const
     return net_.mtu();
 }
 
+gcomm::Socket::Stats gcomm::AsioTcpSocket::stats() const
+{
+    Stats ret;
+    ret.send_q_len_   = send_q_.size();
+    ret.send_q_bytes_ = send_q_bytes_;
+    ret.tx_bytes_     = tx_bytes_;
+    ret.rx_bytes_     = rx_bytes_;
+#if defined(__linux__)
+    if (state_ == S_CONNECTED)
+    {
+        struct tcp_info tcpi;
+        socklen_t tcpi_len(sizeof(tcpi));
+        memset(&tcpi, 0, sizeof(tcpi));
+        int const fd(const_cast<AsioTcpSocket*>(this)->socket().native());
+        if (getsockopt(fd, SOL_TCP, TCP_INFO, &tcpi, &tcpi_len) == 0)
+        {
+            ret.rtt_    = tcpi.tcpi_rtt;
+            ret.rttvar_ = tcpi.tcpi_rttvar;
+        }
+    }
+#endif /* __linux__ */
+    return ret;
+}
+
 
 
 std::string gcomm::AsioTcpSocket::local_addr() const
@@ -585,10 +686,11 @@ void gcomm::AsioTcpSocket::read_one(boost::array<asio::mutable_buffer, 1>& mbs)
                                shared_from_this(),
                                asio::placeholders::error,
                                asio::placeholders::bytes_transferred),
-                   boost::bind(&AsioTcpSocket::read_handler,
-                               shared_from_this(),
-                               asio::placeholders::error,
-                               asio::placeholders::bytes_transferred));
+                   strand_.wrap(
+                       boost::bind(&AsioTcpSocket::read_handler,
+                                   shared_from_this(),
+                                   asio::placeholders::error,
+                                   asio::placeholders::bytes_transferred)));
     }
     else
     {
@@ -598,10 +700,11 @@ void gcomm::AsioTcpSocket::read_one(boost::array<asio::mutable_buffer, 1>& mbs)
                                shared_from_this(),
                                asio::placeholders::error,
                                asio::placeholders::bytes_transferred),
-                   boost::bind(&AsioTcpSocket::read_handler,
-                               shared_from_this(),
-                               asio::placeholders::error,
-                               asio::placeholders::bytes_transferred));
+                   strand_.wrap(
+                       boost::bind(&AsioTcpSocket::read_handler,
+                                   shared_from_this(),
+                                   asio::placeholders::error,
+                                   asio::placeholders::bytes_transferred)));
 #ifdef HAVE_ASIO_SSL_HPP
     }
 #endif /* HAVE_ASIO_SSL_HPP */
@@ -615,19 +718,21 @@ void gcomm::AsioTcpSocket::write_one(
     if (ssl_socket_ != 0)
     {
         async_write(*ssl_socket_, cbs,
-                    boost::bind(&AsioTcpSocket::write_handler,
-                                shared_from_this(),
-                                asio::placeholders::error,
-                                asio::placeholders::bytes_transferred));
+                    strand_.wrap(
+                        boost::bind(&AsioTcpSocket::write_handler,
+                                    shared_from_this(),
+                                    asio::placeholders::error,
+                                    asio::placeholders::bytes_transferred)));
     }
     else
     {
 #endif /* HAVE_ASIO_SSL_HPP */
         async_write(socket_, cbs,
-                    boost::bind(&AsioTcpSocket::write_handler,
-                                shared_from_this(),
-                                asio::placeholders::error,
-                                asio::placeholders::bytes_transferred));
+                    strand_.wrap(
+                        boost::bind(&AsioTcpSocket::write_handler,
+                                    shared_from_this(),
+                                    asio::placeholders::error,
+                                    asio::placeholders::bytes_transferred)));
 #ifdef HAVE_ASIO_SSL_HPP
     }
 #endif /* HAVE_ASIO_SSL_HPP */
@@ -748,9 +853,10 @@ void gcomm::AsioTcpAcceptor::accept_handler(
                           << s->local_addr();
                 s->ssl_socket_->async_handshake(
                     asio::ssl::stream<asio::ip::tcp::socket>::server,
-                    boost::bind(&AsioTcpSocket::handshake_handler,
-                                s->shared_from_this(),
-                                asio::placeholders::error));
+                    s->strand_.wrap(
+                        boost::bind(&AsioTcpSocket::handshake_handler,
+                                    s->shared_from_this(),
+                                    asio::placeholders::error)));
                 s->state_ = Socket::S_CONNECTING;
             }
             else
@@ -776,7 +882,7 @@ void gcomm::AsioTcpAcceptor::accept_handler(
         {
             new_socket->ssl_socket_ =
                 new asio::ssl::stream<asio::ip::tcp::socket>(
-                    net_.io_service_, net_.ssl_context_);
+                    net_.socket_service(), net_.ssl_context_);
             acceptor_.async_accept(new_socket->ssl_socket_->lowest_layer(),
                                    boost::bind(&AsioTcpAcceptor::accept_handler,
                                                this,
@@ -824,7 +930,7 @@ void gcomm::AsioTcpAcceptor::listen(const gu::URI& uri)
         {
             new_socket->ssl_socket_ =
                 new asio::ssl::stream<asio::ip::tcp::socket>(
-                    net_.io_service_, net_.ssl_context_);
+                    net_.socket_service(), net_.ssl_context_);
             acceptor_.async_accept(new_socket->ssl_socket_->lowest_layer(),
                                    boost::bind(&AsioTcpAcceptor::accept_handler,
                                                this,
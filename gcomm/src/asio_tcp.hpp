@@ -63,6 +63,7 @@ public:
     std::string remote_addr() const;
     State state() const { return state_; }
     SocketId id() const { return &socket_; }
+    Stats stats() const;
 private:
     friend class gcomm::AsioTcpAcceptor;
     friend class gcomm::AsioPostForSendHandler;
@@ -92,9 +93,14 @@ private:
 #ifdef HAVE_ASIO_SSL_HPP
     asio::ssl::stream<asio::ip::tcp::socket>* ssl_socket_;
 #endif // HAVE_ASIO_SSL_HPP
+    asio::io_service::strand                  strand_;
     std::deque<Datagram>                      send_q_;
+    size_t                                    send_q_bytes_;
+    long long                                 tx_bytes_;
+    long long                                 rx_bytes_;
     std::vector<gu::byte_t>                   recv_buf_;
     size_t                                    recv_offset_;
+    std::vector<Datagram>                     recv_dgs_;
     State                                     state_;
     // Querying addresses from failed socket does not work,
     // so need to maintain copy for diagnostics logging
@@ -6,6 +6,7 @@
 
 #include "gcomm/util.hpp"
 #include "gcomm/common.hpp"
+#include "gcomm/conf.hpp"
 
 #include <boost/bind.hpp>
 #include <boost/array.hpp>
@@ -59,7 +60,14 @@ gcomm::AsioUdpSocket::AsioUdpSocket(AsioProtonet& net, const gu::URI& uri)
     socket_(net_.io_service_),
     target_ep_(),
     source_ep_(),
-    recv_buf_((1 << 15) + NetHeader::serial_size_)
+    recv_buf_((1 << 15) + NetHeader::serial_size_),
+    rate_(0),
+    tokens_(0),
+    tokens_tstamp_(gu::datetime::Date::zero()),
+    pace_q_(),
+    pace_timer_(net_.io_service_),
+    tx_bytes_(0),
+    rx_bytes_(0)
 { }
 
 
@@ -87,6 +95,13 @@ void gcomm::AsioUdpSocket::connect(const gu::URI& uri)
     gu::set_fd_options(socket_);
     asio::ip::udp::socket::non_blocking_io cmd(true);
     socket_.io_control(cmd);
+    // datagrams which don't fit into receive buffer are lost, so
+    // honour configured buffer size like TCP sockets do
+    socket_.set_option(asio::socket_base::receive_buffer_size(
+                           net_.conf().get<size_t>(Conf::SocketRecvBufSize)));
+
+    rate_ = gu::from_string<size_t>(uri.get_option(OptMcastRate, "0"));
+    tokens_tstamp_ = gu::datetime::Date::now();
 
     const std::string if_addr(
         gu::unescape_addr(
@@ -126,6 +141,8 @@ void gcomm::AsioUdpSocket::close()
         {
             leave_group(socket_, target_ep_);
         }
+        pace_timer_.cancel();
+        pace_q_.clear();
         socket_.close();
     }
     state_ = S_CLOSED;
@@ -134,6 +151,31 @@ void gcomm::AsioUdpSocket::close()
 int gcomm::AsioUdpSocket::send(const Datagram& dg)
 {
     Critical<AsioProtonet> crit(net_);
+
+    if (rate_ == 0)
+    {
+        return send_to(dg);
+    }
+
+    if (pace_q_.empty() == true)
+    {
+        const size_t len(dg.len() + NetHeader::serial_size_);
+        refill_tokens();
+        if (tokens_ >= len)
+        {
+            tokens_ -= len;
+            return send_to(dg);
+        }
+        schedule_pacing(len);
+    }
+    // payload is shared, only header is copied
+    pace_q_.push_back(dg);
+    return 0;
+}
+
+
+int gcomm::AsioUdpSocket::send_to(const Datagram& dg)
+{
     boost::array<asio::const_buffer, 3> cbs;
     NetHeader hdr(dg.len(), net_.version_);
 
@@ -147,10 +189,12 @@ int gcomm::AsioUdpSocket::send(const Datagram& dg)
     cbs[0] = asio::const_buffer(buf, sizeof(buf));
     cbs[1] = asio::const_buffer(dg.header() + dg.header_offset(),
                           dg.header_len());
-    cbs[2] = asio::const_buffer(&dg.payload()[0], dg.payload().size());
+    cbs[2] = asio::const_buffer(&dg.payload()[0] + dg.payload_offset(),
+                                dg.payload().size() - dg.payload_offset());
     try
     {
         socket_.send_to(cbs, target_ep_);
+        tx_bytes_ += dg.len() + NetHeader::serial_size_;
     }
     catch (asio::system_error& err)
     {
@@ -161,6 +205,61 @@ int gcomm::AsioUdpSocket::send(const Datagram& dg)
 }
 
 
+void gcomm::AsioUdpSocket::refill_tokens()
+{
+    const gu::datetime::Date now(gu::datetime::Date::now());
+    // allow bursts of 10ms worth of data, but at least one
+    // maximum size datagram
+    const double max_tokens(std::max(double(rate_)/100,
+                                     double(recv_buf_.size())));
+    tokens_ = std::min(max_tokens,
+                       tokens_ + double(rate_)*
+                       (now - tokens_tstamp_).get_nsecs()/gu::datetime::Sec);
+    tokens_tstamp_ = now;
+}
+
+
+void gcomm::AsioUdpSocket::schedule_pacing(size_t len)
+{
+    const long long usecs(
+        (double(len) - tokens_)*1000000/rate_ + 1);
+    pace_timer_.expires_from_now(boost::posix_time::microseconds(usecs));
+    pace_timer_.async_wait(boost::bind(&AsioUdpSocket::pace_handler,
+                                       shared_from_this(),
+                                       asio::placeholders::error));
+}
+
+
+void gcomm::AsioUdpSocket::pace_handler(const asio::error_code& ec)
+{
+    if (ec)
+    {
+        return;
+    }
+
+    Critical<AsioProtonet> crit(net_);
+
+    if (state() != S_CONNECTED)
+    {
+        return;
+    }
+
+    refill_tokens();
+    while (pace_q_.empty() == false)
+    {
+        const size_t len(pace_q_.front().len() + NetHeader::serial_size_);
+        if (tokens_ < len)
+        {
+            schedule_pacing(len);
+            return;
+        }
+        tokens_ -= len;
+        (void)send_to(pace_q_.front());
+        pace_q_.pop_front();
+    }
+}
+
+
 void gcomm::AsioUdpSocket::read_handler(const asio::error_code& ec,
                                         size_t bytes_transferred)
 {
@@ -205,6 +304,7 @@ void gcomm::AsioUdpSocket::read_handler(const asio::error_code& ec,
             }
             else
             {
+                rx_bytes_ += bytes_transferred;
                 net_.dispatch(id(), dg, ProtoUpMeta());
             }
         }
@@ -234,6 +334,20 @@ size_t gcomm::AsioUdpSocket::mtu() const
     return (1 << 15);
 }
 
+gcomm::Socket::Stats gcomm::AsioUdpSocket::stats() const
+{
+    Stats ret;
+    ret.send_q_len_ = pace_q_.size();
+    for (std::deque<Datagram>::const_iterator i(pace_q_.begin());
+         i != pace_q_.end(); ++i)
+    {
+        ret.send_q_bytes_ += i->len() + NetHeader::serial_size_;
+    }
+    ret.tx_bytes_ = tx_bytes_;
+    ret.rx_bytes_ = rx_bytes_;
+    return ret;
+}
+
 std::string gcomm::AsioUdpSocket::local_addr() const
 {
     return uri_string(gu::scheme::udp,
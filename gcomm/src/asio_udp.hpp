@@ -7,7 +7,9 @@
 
 #include "socket.hpp"
 #include "asio_protonet.hpp"
+#include "gu_datetime.hpp"
 #include <boost/enable_shared_from_this.hpp>
+#include <deque>
 #include <vector>
 
 //
@@ -39,20 +41,35 @@ public:
     void set_option(const std::string&, const std::string&) { /* not implemented */ }
     int send(const Datagram& dg);
     void read_handler(const asio::error_code&, size_t);
+    void pace_handler(const asio::error_code&);
     void async_receive();
     size_t mtu() const;
     std::string local_addr() const;
     std::string remote_addr() const;
     State state() const { return state_; }
     SocketId id() const { return &socket_; }
+    Stats stats() const;
 
 private:
+    int  send_to(const Datagram& dg);
+    void refill_tokens();
+    void schedule_pacing(size_t len);
+
     AsioProtonet&            net_;
     State                    state_;
     asio::ip::udp::socket    socket_;
     asio::ip::udp::endpoint  target_ep_;
     asio::ip::udp::endpoint  source_ep_;
     std::vector<gu::byte_t>  recv_buf_;
+    // Send pacing: token bucket filled at rate_ bytes per second,
+    // datagrams exceeding the rate wait in pace_q_ for pace_timer_
+    size_t                   rate_;
+    double                   tokens_;
+    gu::datetime::Date       tokens_tstamp_;
+    std::deque<Datagram>     pace_q_;
+    asio::deadline_timer     pace_timer_;
+    long long                tx_bytes_;
+    long long                rx_bytes_;
 };
 
 #if defined(__GNUG__)
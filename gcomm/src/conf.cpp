@@ -22,6 +22,8 @@ std::string const gcomm::Conf::SocketChecksum =
     SocketPrefix + "checksum";
 std::string const gcomm::Conf::SocketRecvBufSize =
     SocketPrefix + "recv_buf_size";
+std::string const gcomm::Conf::SocketIoThreads =
+    SocketPrefix + "io_threads";
 
 // GMCast
 std::string const gcomm::Conf::GMCastScheme = "gmcast";
@@ -38,6 +40,8 @@ std::string const gcomm::Conf::GMCastMCastPort =
     GMCastPrefix + "mcast_port";
 std::string const gcomm::Conf::GMCastMCastTTL =
     GMCastPrefix + "mcast_ttl";
+std::string const gcomm::Conf::GMCastMCastRate =
+    GMCastPrefix + "mcast_rate";
 std::string const gcomm::Conf::GMCastTimeWait =
     GMCastPrefix + "time_wait";
 std::string const gcomm::Conf::GMCastPeerTimeout =
@@ -48,6 +52,8 @@ std::string const gcomm::Conf::GMCastPeerAddr =
     GMCastPrefix + "peer_addr";
 std::string const gcomm::Conf::GMCastIsolate =
     GMCastPrefix + "isolate";
+std::string const gcomm::Conf::GMCastMaxMessageSize =
+    GMCastPrefix + "max_message_size";
 std::string const gcomm::Conf::GMCastSegment =
     GMCastPrefix + "segment";
 
@@ -82,6 +88,12 @@ std::string const gcomm::Conf::EvsUserSendWindow =
     EvsPrefix + "user_send_window";
 std::string const gcomm::Conf::EvsUseAggregate =
     EvsPrefix + "use_aggregate";
+std::string const gcomm::Conf::EvsAggregateDelay =
+    EvsPrefix + "aggregate_delay";
+std::string const gcomm::Conf::EvsAggregateSize =
+    EvsPrefix + "aggregate_size";
+std::string const gcomm::Conf::EvsGapRequestPeriod =
+    EvsPrefix + "gap_request_period";
 std::string const gcomm::Conf::EvsCausalKeepalivePeriod =
     EvsPrefix + "causal_keepalive_period";
 std::string const gcomm::Conf::EvsMaxInstallTimeouts =
@@ -130,6 +142,7 @@ gcomm::Conf::register_params(gu::Config& cnf)
     GCOMM_CONF_ADD        (TcpNonBlocking);
     GCOMM_CONF_ADD_DEFAULT(SocketChecksum);
     GCOMM_CONF_ADD_DEFAULT(SocketRecvBufSize);
+    GCOMM_CONF_ADD_DEFAULT(SocketIoThreads);
 
     GCOMM_CONF_ADD_DEFAULT(GMCastVersion);
     GCOMM_CONF_ADD        (GMCastGroup);
@@ -137,12 +150,14 @@ gcomm::Conf::register_params(gu::Config& cnf)
     GCOMM_CONF_ADD        (GMCastMCastAddr);
     GCOMM_CONF_ADD        (GMCastMCastPort);
     GCOMM_CONF_ADD        (GMCastMCastTTL);
+    GCOMM_CONF_ADD_DEFAULT(GMCastMCastRate);
     GCOMM_CONF_ADD        (GMCastMCastAddr);
     GCOMM_CONF_ADD        (GMCastTimeWait);
     GCOMM_CONF_ADD        (GMCastPeerTimeout);
     GCOMM_CONF_ADD        (GMCastMaxInitialReconnectAttempts);
     GCOMM_CONF_ADD        (GMCastPeerAddr);
     GCOMM_CONF_ADD        (GMCastIsolate);
+    GCOMM_CONF_ADD_DEFAULT(GMCastMaxMessageSize);
     GCOMM_CONF_ADD_DEFAULT(GMCastSegment);
 
     GCOMM_CONF_ADD        (EvsVersion);
@@ -159,6 +174,9 @@ gcomm::Conf::register_params(gu::Config& cnf)
     GCOMM_CONF_ADD_DEFAULT(EvsSendWindow);
     GCOMM_CONF_ADD_DEFAULT(EvsUserSendWindow);
     GCOMM_CONF_ADD        (EvsUseAggregate);
+    GCOMM_CONF_ADD_DEFAULT(EvsAggregateDelay);
+    GCOMM_CONF_ADD_DEFAULT(EvsAggregateSize);
+    GCOMM_CONF_ADD_DEFAULT(EvsGapRequestPeriod);
     GCOMM_CONF_ADD        (EvsCausalKeepalivePeriod);
     GCOMM_CONF_ADD_DEFAULT(EvsMaxInstallTimeouts);
     GCOMM_CONF_ADD_DEFAULT(EvsDelayMargin);
@@ -58,6 +58,8 @@ gcomm::crc16(const gcomm::Datagram& dg, size_t offset)
         offset -= dg.header_len();
     }
 
+    offset += dg.payload_offset_;
+
     crc.process_block(&(*dg.payload_)[0] + offset,
                       &(*dg.payload_)[0] + dg.payload_->size());
 
@@ -91,6 +93,8 @@ gcomm::crc32(gcomm::NetHeader::checksum_t const type,
             offset -= dg.header_len();
         }
 
+        offset += dg.payload_offset_;
+
         crc.process_block(&(*dg.payload_)[0] + offset,
                           &(*dg.payload_)[0] + dg.payload_->size());
 
@@ -113,6 +117,8 @@ gcomm::crc32(gcomm::NetHeader::checksum_t const type,
             offset -= dg.header_len();
         }
 
+        offset += dg.payload_offset_;
+
         crc.append (&(*dg.payload_)[0] + offset, dg.payload_->size() - offset);
 
         return crc();
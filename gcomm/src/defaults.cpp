@@ -17,11 +17,14 @@ namespace gcomm
     std::string const Defaults::ProtonetVersion         = "0";
     std::string const Defaults::SocketChecksum          = "2";
     std::string const Defaults::SocketRecvBufSize       = "212992";
+    std::string const Defaults::SocketIoThreads         = "0";
     std::string const Defaults::GMCastVersion           = "0";
     std::string const Defaults::GMCastTcpPort           = BASE_PORT_DEFAULT;
     std::string const Defaults::GMCastSegment           = "0";
     std::string const Defaults::GMCastTimeWait          = "PT5S";
     std::string const Defaults::GMCastPeerTimeout       = "PT3S";
+    std::string const Defaults::GMCastMaxMessageSize    = "4194304";
+    std::string const Defaults::GMCastMCastRate         = "0";
     std::string const Defaults::EvsViewForgetTimeout    = "PT24H";
     std::string const Defaults::EvsViewForgetTimeoutMin = "PT1S";
     std::string const Defaults::EvsInactiveCheckPeriod  = "PT0.5S";
@@ -38,6 +41,9 @@ namespace gcomm
     std::string const Defaults::EvsSendWindowMin        = "1";
     std::string const Defaults::EvsUserSendWindow       = "2";
     std::string const Defaults::EvsUserSendWindowMin    = "1";
+    std::string const Defaults::EvsAggregateDelay       = "PT0S";
+    std::string const Defaults::EvsAggregateSize        = "0";
+    std::string const Defaults::EvsGapRequestPeriod     = "PT0S";
     std::string const Defaults::EvsMaxInstallTimeouts   = "3";
     std::string const Defaults::EvsDelayMargin          = "PT1S";
     std::string const Defaults::EvsDelayedKeepPeriod    = "PT30S";
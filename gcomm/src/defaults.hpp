@@ -15,11 +15,14 @@ namespace gcomm
         static std::string const ProtonetVersion          ;
         static std::string const SocketChecksum           ;
         static std::string const SocketRecvBufSize        ;
+        static std::string const SocketIoThreads          ;
         static std::string const GMCastVersion            ;
         static std::string const GMCastTcpPort            ;
         static std::string const GMCastSegment            ;
         static std::string const GMCastTimeWait           ;
         static std::string const GMCastPeerTimeout        ;
+        static std::string const GMCastMaxMessageSize     ;
+        static std::string const GMCastMCastRate          ;
         static std::string const EvsViewForgetTimeout     ;
         static std::string const EvsViewForgetTimeoutMin  ;
         static std::string const EvsInactiveCheckPeriod   ;
@@ -36,6 +39,9 @@ namespace gcomm
         static std::string const EvsSendWindowMin         ;
         static std::string const EvsUserSendWindow        ;
         static std::string const EvsUserSendWindowMin     ;
+        static std::string const EvsAggregateDelay        ;
+        static std::string const EvsAggregateSize         ;
+        static std::string const EvsGapRequestPeriod      ;
         static std::string const EvsMaxInstallTimeouts    ;
         static std::string const EvsDelayMargin           ;
         static std::string const EvsDelayedKeepPeriod     ;
@@ -90,6 +90,18 @@ std::ostream& gcomm::evs::operator<<(std::ostream& os, const InputMapMsg& m)
 }
 
 
+std::ostream& gcomm::evs::operator<<(std::ostream& os,
+                                     const InputMapMsgIndex& mi)
+{
+    for (InputMapMsgIndex::const_iterator i(mi.begin()); i != mi.end(); ++i)
+    {
+        os << "\t" << InputMapMsgIndex::key(i) << ","
+           << InputMapMsgIndex::value(i) << "\n";
+    }
+    return os;
+}
+
+
 std::ostream& gcomm::evs::operator<<(std::ostream& os, const InputMap& im)
 {
     return (os << "evs::input_map: {"
@@ -106,6 +118,275 @@ std::ostream& gcomm::evs::operator<<(std::ostream& os, const InputMap& im)
 
 
 
+//////////////////////////////////////////////////////////////////////////
+//
+// InputMapMsgIndex
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+gcomm::evs::InputMapMsgIndex::InputMapMsgIndex() :
+    alloc_    (),
+    slots_    (),
+    row_size_ (),
+    nodes_    (0),
+    rows_     (0),
+    begin_seq_(0),
+    end_seq_  (0),
+    size_     (0)
+{ }
+
+
+gcomm::evs::InputMapMsgIndex::~InputMapMsgIndex()
+{
+    clear();
+}
+
+
+void gcomm::evs::InputMapMsgIndex::reset(const size_t nodes)
+{
+    clear();
+    nodes_ = nodes;
+    rows_  = 0;
+    std::vector<InputMapMsg*>().swap(slots_);
+    std::vector<size_t>().swap(row_size_);
+}
+
+
+gcomm::evs::InputMapMsgIndex::iterator
+gcomm::evs::InputMapMsgIndex::begin() const
+{
+    if (size_ == 0) return end();
+
+    iterator ret(this, begin_seq_, npos);
+    next(ret);
+    return ret;
+}
+
+
+void gcomm::evs::InputMapMsgIndex::next(iterator& i) const
+{
+    seqno_t seq (i.seq_);
+    size_t  node(i.node_ == npos ? 0 : i.node_ + 1);
+
+    for (; seq < end_seq_; ++seq, node = 0)
+    {
+        if (row_size_[row(seq)] == 0) continue;
+
+        InputMapMsg* const* const r(&slots_[row(seq) * nodes_]);
+
+        for (; node < nodes_; ++node)
+        {
+            if (r[node] != 0)
+            {
+                i.seq_  = seq;
+                i.node_ = node;
+                return;
+            }
+        }
+    }
+
+    i = end();
+}
+
+
+gcomm::evs::InputMapMsgIndex::iterator
+gcomm::evs::InputMapMsgIndex::find(const InputMapMsgKey& key) const
+{
+    if (at(key.seq(), key.index()) == 0) return end();
+
+    return iterator(this, key.seq(), key.index());
+}
+
+
+gcomm::evs::InputMapMsgIndex::iterator
+gcomm::evs::InputMapMsgIndex::find_checked(const InputMapMsgKey& key) const
+{
+    iterator ret(find(key));
+
+    if (ret == end())
+    {
+        gu_throw_fatal << "element " << key << " not found";
+    }
+
+    return ret;
+}
+
+
+void gcomm::evs::InputMapMsgIndex::insert_unique(const InputMapMsgKey& key,
+                                                 const InputMapMsg&    msg)
+{
+    if (at(key.seq(), key.index()) != 0)
+    {
+        gu_throw_fatal << "duplicate entry key=" << key << " value=" << msg;
+    }
+
+    InputMapMsg* const m(alloc_.allocate(1));
+
+    try
+    {
+        alloc_.construct(m, msg);
+    }
+    catch (...)
+    {
+        alloc_.deallocate(m, 1);
+        throw;
+    }
+
+    try
+    {
+        insert(key, m);
+    }
+    catch (...)
+    {
+        destroy(m);
+        throw;
+    }
+}
+
+
+void gcomm::evs::InputMapMsgIndex::erase(iterator i)
+{
+    InputMapMsg* const m(at(i.seq_, i.node_));
+    gcomm_assert(m != 0) << "invalid iterator " << key(i);
+    remove(i.seq_, i.node_);
+    destroy(m);
+}
+
+
+void gcomm::evs::InputMapMsgIndex::transfer(iterator i, InputMapMsgIndex& to)
+{
+    InputMapMsg* const m(at(i.seq_, i.node_));
+    gcomm_assert(m != 0) << "invalid iterator " << key(i);
+
+    if (to.at(i.seq_, i.node_) != 0)
+    {
+        gu_throw_fatal << "duplicate entry key=" << key(i) << " value=" << *m;
+    }
+
+    to.insert(key(i), m);
+    remove(i.seq_, i.node_);
+}
+
+
+void gcomm::evs::InputMapMsgIndex::erase_below(const seqno_t seq)
+{
+    for (; begin_seq_ < seq && size_ > 0; ++begin_seq_)
+    {
+        const size_t r(row(begin_seq_));
+
+        if (row_size_[r] == 0) continue;
+
+        for (size_t n(0); n < nodes_; ++n)
+        {
+            InputMapMsg*& m(slots_[r * nodes_ + n]);
+            if (m != 0)
+            {
+                destroy(m);
+                m = 0;
+            }
+        }
+
+        size_ -= row_size_[r];
+        row_size_[r] = 0;
+    }
+
+    while (begin_seq_ < end_seq_ && row_size_[row(begin_seq_)] == 0)
+    {
+        ++begin_seq_;
+    }
+}
+
+
+void gcomm::evs::InputMapMsgIndex::clear()
+{
+    erase_below(end_seq_);
+    gcomm_assert(size_ == 0);
+}
+
+
+void gcomm::evs::InputMapMsgIndex::insert(const InputMapMsgKey& key,
+                                          InputMapMsg* const    msg)
+{
+    const seqno_t seq (key.seq());
+    const size_t  node(key.index());
+
+    gcomm_assert(seq >= 0 && node < nodes_)
+        << "invalid key " << key << ", nodes " << nodes_;
+
+    if (size_ == 0)
+    {
+        reserve(seq, seq + 1);
+    }
+    else
+    {
+        reserve(std::min(begin_seq_, seq), std::max(end_seq_, seq + 1));
+    }
+
+    InputMapMsg*& m(slot(seq, node));
+    assert(m == 0);
+    m = msg;
+    ++row_size_[row(seq)];
+    ++size_;
+}
+
+
+void gcomm::evs::InputMapMsgIndex::remove(const seqno_t seq, const size_t node)
+{
+    InputMapMsg*& m(slot(seq, node));
+    assert(m != 0);
+    m = 0;
+    --row_size_[row(seq)];
+    --size_;
+
+    while (begin_seq_ < end_seq_ && row_size_[row(begin_seq_)] == 0)
+    {
+        ++begin_seq_;
+    }
+}
+
+
+void gcomm::evs::InputMapMsgIndex::destroy(InputMapMsg* const msg)
+{
+    alloc_.destroy(msg);
+    alloc_.deallocate(msg, 1);
+}
+
+
+void gcomm::evs::InputMapMsgIndex::reserve(const seqno_t begin,
+                                           const seqno_t end)
+{
+    const size_t span(end - begin);
+
+    if (span > rows_)
+    {
+        size_t rows(rows_ > 0 ? rows_ : 16);
+        while (rows < span) rows *= 2;
+
+        std::vector<InputMapMsg*> slots(rows * nodes_, 0);
+        std::vector<size_t>       row_size(rows, 0);
+
+        for (seqno_t seq(begin_seq_); size_ > 0 && seq < end_seq_; ++seq)
+        {
+            const size_t from(row(seq));
+            const size_t to  (static_cast<size_t>(seq) & (rows - 1));
+
+            std::copy(slots_.begin() + from * nodes_,
+                      slots_.begin() + (from + 1) * nodes_,
+                      slots.begin() + to * nodes_);
+            row_size[to] = row_size_[from];
+        }
+
+        slots_.swap(slots);
+        row_size_.swap(row_size);
+        rows_ = rows;
+    }
+
+    begin_seq_ = begin;
+    end_seq_   = end;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //
 // Constructors/destructors
@@ -147,6 +428,8 @@ void gcomm::evs::InputMap::reset(const size_t nodes, const seqno_t window)
     node_index_->clear();
 
     window_ = window;
+    msg_index_->reset(nodes);
+    recovery_index_->reset(nodes);
     log_debug << " size " << node_index_->size();
     gu_trace(node_index_->resize(nodes, InputMapNode()));
     for (size_t i = 0; i < nodes; ++i)
@@ -288,19 +571,18 @@ gcomm::evs::InputMap::insert(const size_t uuid,
             Datagram ins_dg(s == msg.seq() ?
                                 Datagram(rb)   :
                                 Datagram());
-            gu_trace((void)msg_index_->insert_unique(
-                         std::make_pair(
-                             InputMapMsgKey(node.index(), s),
-                             InputMapMsg(
-                                 (s == msg.seq() ?
-                                  msg :
-                                  UserMessage(msg.version(),
-                                              msg.source(),
-                                              msg.source_view_id(),
-                                              s,
-                                              msg.aru_seq(),
-                                              0,
-                                              O_DROP)), ins_dg))));
+            gu_trace(msg_index_->insert_unique(
+                         InputMapMsgKey(node.index(), s),
+                         InputMapMsg(
+                             (s == msg.seq() ?
+                              msg :
+                              UserMessage(msg.version(),
+                                          msg.source(),
+                                          msg.source_view_id(),
+                                          s,
+                                          msg.aru_seq(),
+                                          0,
+                                          O_DROP)), ins_dg)));
         }
 
         // Update highest seen
@@ -335,8 +617,7 @@ gcomm::evs::InputMap::insert(const size_t uuid,
 
 void gcomm::evs::InputMap::erase(iterator i)
 {
-    gu_trace(recovery_index_->insert_unique(*i));
-    gu_trace(msg_index_->erase(i));
+    gu_trace(msg_index_->transfer(i, *recovery_index_));
 }
 
 
@@ -385,7 +666,5 @@ inline void gcomm::evs::InputMap::update_aru()
 void gcomm::evs::InputMap::cleanup_recovery_index()
 {
     gcomm_assert(node_index_->size() > 0);
-    InputMapMsgIndex::iterator i = recovery_index_->lower_bound(
-        InputMapMsgKey(0, safe_seq_ + 1));
-    recovery_index_->erase(recovery_index_->begin(), i);
+    recovery_index_->erase_below(safe_seq_ + 1);
 }
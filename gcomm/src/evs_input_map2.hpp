@@ -24,6 +24,7 @@
 #include "gcomm/datagram.hpp"
 
 #include <vector>
+#include <memory>
 
 
 namespace gcomm
@@ -36,6 +37,7 @@ namespace gcomm
         class InputMapMsg;
         std::ostream& operator<<(std::ostream&, const InputMapMsg&);
         class InputMapMsgIndex;
+        std::ostream& operator<<(std::ostream&, const InputMapMsgIndex&);
         class InputMapNode;
         std::ostream& operator<<(std::ostream&, const InputMapNode&);
         typedef std::vector<InputMapNode> InputMapNodeIndex;
@@ -93,31 +95,142 @@ private:
 
 
 #if defined(GALERA_USE_BOOST_POOL_ALLOC)
-
 #include <boost/pool/pool_alloc.hpp>
+#endif /* GALERA_USE_BOOST_POOL_ALLOC */
+
+/*!
+ * Index of messages ordered by (seq, index).
+ *
+ * Seqnos of messages in the index are dense for each node, so messages are
+ * kept in a window of rows, one row per seqno with a slot for each node.
+ * Rows are stored in a ring buffer which is grown when the window does not
+ * fit in it. Insert, find and erase are O(1), iteration walks the window
+ * in key order.
+ *
+ * Iterators refer to (seq, index) position and stay valid until the
+ * message they point to is erased.
+ */
+class gcomm::evs::InputMapMsgIndex
+{
+public:
+
+    class iterator
+    {
+    public:
+        iterator() : idx_(0), seq_(-1), node_(npos) { }
+
+        iterator& operator++() { idx_->next(*this); return *this; }
+
+        bool operator==(const iterator& i) const
+        {
+            return (node_ == i.node_ && (node_ == npos || seq_ == i.seq_));
+        }
+
+        bool operator!=(const iterator& i) const { return !(*this == i); }
+
+    private:
+
+        friend class InputMapMsgIndex;
+
+        iterator(const InputMapMsgIndex* idx, seqno_t seq, size_t node)
+            : idx_(idx), seq_(seq), node_(node) { }
+
+        const InputMapMsgIndex* idx_;
+        seqno_t                 seq_;
+        size_t                  node_;
+    };
+
+    typedef iterator const_iterator;
+
+    static InputMapMsgKey key(const_iterator i)
+    {
+        return InputMapMsgKey(i.node_, i.seq_);
+    }
+
+    static const InputMapMsg& value(const_iterator i)
+    {
+        return *i.idx_->at(i.seq_, i.node_);
+    }
+
+    InputMapMsgIndex();
+    ~InputMapMsgIndex();
 
-class gcomm::evs::InputMapMsgIndex :
-    public Map<InputMapMsgKey, InputMapMsg,
-               std::map<InputMapMsgKey,
-                        InputMapMsg,
-                        std::less<InputMapMsgKey>,
-                        boost::fast_pool_allocator<
-                            std::pair<const InputMapMsgKey, InputMapMsg>,
-                            boost::default_user_allocator_new_delete,
-                            boost::details::pool::null_mutex
-                            >
-                        >
-               >
-{};
-
-#else /* GALERA_USE_BOOST_POOL_ALLOC */
-
-class gcomm::evs::InputMapMsgIndex :
-    public Map<InputMapMsgKey, InputMapMsg>
-{};
+    /*! Clear index and set the number of nodes */
+    void reset(size_t nodes);
 
+    iterator begin() const;
+    iterator end()   const { return iterator(this, -1, npos); }
+
+    iterator find        (const InputMapMsgKey& key) const;
+    iterator find_checked(const InputMapMsgKey& key) const;
+
+    /*! @throws FatalException if key is already present */
+    void insert_unique(const InputMapMsgKey& key, const InputMapMsg& msg);
+
+    void erase(iterator i);
+
+    /*! Move message pointed by iterator to another index */
+    void transfer(iterator i, InputMapMsgIndex& to);
+
+    /*! Erase all messages with seqno lower than seq */
+    void erase_below(seqno_t seq);
+
+    void clear();
+
+    size_t size()  const { return size_; }
+    bool   empty() const { return (0 == size_); }
+
+private:
+
+    InputMapMsgIndex(const InputMapMsgIndex&);
+    void operator=(const InputMapMsgIndex&);
+
+    static size_t const npos = size_t(-1);
+
+#if defined(GALERA_USE_BOOST_POOL_ALLOC)
+    typedef boost::fast_pool_allocator<
+        InputMapMsg,
+        boost::default_user_allocator_new_delete,
+        boost::details::pool::null_mutex> MsgAlloc;
+#else
+    typedef std::allocator<InputMapMsg>   MsgAlloc;
 #endif /* GALERA_USE_BOOST_POOL_ALLOC */
 
+    size_t row(seqno_t seq) const
+    {
+        return (static_cast<size_t>(seq) & (rows_ - 1));
+    }
+
+    InputMapMsg*& slot(seqno_t seq, size_t node)
+    {
+        return slots_[row(seq) * nodes_ + node];
+    }
+
+    /* returns message at (seq, node) or 0 if not present */
+    InputMapMsg* at(seqno_t seq, size_t node) const
+    {
+        if (seq < begin_seq_ || seq >= end_seq_ || node >= nodes_) return 0;
+        return slots_[row(seq) * nodes_ + node];
+    }
+
+    void insert(const InputMapMsgKey& key, InputMapMsg* msg);
+    void remove(seqno_t seq, size_t node);
+    void destroy(InputMapMsg* msg);
+    void reserve(seqno_t begin, seqno_t end);
+    void next(iterator& i) const;
+
+    friend std::ostream& operator<<(std::ostream&, const InputMapMsgIndex&);
+
+    MsgAlloc                  alloc_;
+    std::vector<InputMapMsg*> slots_;
+    std::vector<size_t>       row_size_; /* number of messages in row */
+    size_t                    nodes_;
+    size_t                    rows_;     /* ring size, power of 2     */
+    seqno_t                   begin_seq_;/* lowest seqno in the index */
+    seqno_t                   end_seq_;  /* past highest seqno        */
+    size_t                    size_;
+};
+
 /* Internal node representation */
 class gcomm::evs::InputMapNode
 {
@@ -48,7 +48,11 @@ gcomm::evs::Node::Node(const Node& n)
     tstamp_          (n.tstamp_),
     seen_tstamp_     (n.seen_tstamp_),
     fifo_seq_        (n.fifo_seq_),
-    segment_         (n.segment_)
+    segment_         (n.segment_),
+    gap_request_hs_  (n.gap_request_hs_),
+    gap_request_tstamp_(n.gap_request_tstamp_),
+    retrans_msgs_    (n.retrans_msgs_),
+    gap_requests_    (n.gap_requests_)
 { }
 
 
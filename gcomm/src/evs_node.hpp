@@ -51,7 +51,11 @@ public:
         tstamp_            (gu::datetime::Date::now()),
         seen_tstamp_       (tstamp_),
         fifo_seq_          (-1),
-        segment_           (0)
+        segment_           (0),
+        gap_request_hs_    (-1),
+        gap_request_tstamp_(gu::datetime::Date::zero()),
+        retrans_msgs_      (0),
+        gap_requests_      (0)
     {}
 
     Node(const Node& n);
@@ -103,6 +107,20 @@ public:
     int64_t fifo_seq() const { return fifo_seq_; }
     SegmentId segment() const { return segment_; }
 
+    void set_gap_request(const seqno_t hs, const gu::datetime::Date& t)
+    {
+        gap_request_hs_     = hs;
+        gap_request_tstamp_ = t;
+    }
+    seqno_t gap_request_hs() const { return gap_request_hs_; }
+    const gu::datetime::Date& gap_request_tstamp() const
+    { return gap_request_tstamp_; }
+
+    void add_retrans_msgs(const long long n) { retrans_msgs_ += n; }
+    long long retrans_msgs() const { return retrans_msgs_; }
+    void add_gap_request() { ++gap_requests_; }
+    long long gap_requests() const { return gap_requests_; }
+
     bool is_inactive() const;
     bool is_suspected() const;
 
@@ -138,6 +156,14 @@ private:
     gu::datetime::Date seen_tstamp_;
     int64_t fifo_seq_;
     SegmentId segment_;
+    // Highest seqno and time of the last retransmission request
+    // sent to this node
+    seqno_t gap_request_hs_;
+    gu::datetime::Date gap_request_tstamp_;
+    // Number of messages retransmitted on request of this node
+    long long retrans_msgs_;
+    // Number of retransmission requests sent to this node
+    long long gap_requests_;
 };
 
 class gcomm::evs::NodeMap : public Map<UUID, Node> { };
@@ -46,7 +46,6 @@ gcomm::evs::Proto::Proto(gu::Config&    conf,
                          const View*    rst_view)
     :
     Protolay(conf),
-    timers_(),
     version_(check_range(Conf::EvsVersion,
                          param<int>(conf, uri, Conf::EvsVersion, "0"),
                          0, GCOMM_PROTOCOL_MAX_VERSION + 1)),
@@ -63,8 +62,14 @@ gcomm::evs::Proto::Proto(gu::Config&    conf,
     sent_msgs_(7, 0),
     retrans_msgs_(0),
     recovered_msgs_(0),
+    gap_requests_(0),
+    gap_requests_suppressed_(0),
+    gaps_filled_(0),
     recvd_msgs_(7, 0),
     delivered_msgs_(O_LOCAL_CAUSAL + 1),
+    aggregated_s_(0),
+    n_aggregated_s_(0),
+    aggregate_hold_(),
     send_user_prof_    ("send_user"),
     send_gap_prof_     ("send_gap"),
     send_join_prof_    ("send_join"),
@@ -187,6 +192,28 @@ gcomm::evs::Proto::Proto(gu::Config&    conf,
     max_output_size_(128),
     mtu_(mtu),
     use_aggregate_(param<bool>(conf, uri, Conf::EvsUseAggregate, "true")),
+    aggregate_delay_(
+        check_range(Conf::EvsAggregateDelay,
+                    param<gu::datetime::Period>(
+                        conf, uri, Conf::EvsAggregateDelay,
+                        Defaults::EvsAggregateDelay),
+                    gu::datetime::Period(0),
+                    gu::datetime::Period::max())),
+    aggregate_size_(
+        check_range(Conf::EvsAggregateSize,
+                    param<size_t>(conf, uri, Conf::EvsAggregateSize,
+                                  Defaults::EvsAggregateSize),
+                    size_t(0), std::numeric_limits<size_t>::max())),
+    aggregate_start_(gu::datetime::Date::max()),
+    last_user_down_(gu::datetime::Date::zero()),
+    gap_request_period_(
+        check_range(Conf::EvsGapRequestPeriod,
+                    param<gu::datetime::Period>(
+                        conf, uri, Conf::EvsGapRequestPeriod,
+                        Defaults::EvsGapRequestPeriod),
+                    gu::datetime::Period(0),
+                    gu::datetime::Period::max())),
+    timers_changed_(false),
     self_loopback_(false),
     state_(S_CLOSED),
     shift_to_rfcnt_(0),
@@ -213,6 +240,9 @@ gcomm::evs::Proto::Proto(gu::Config&    conf,
     conf.set(Conf::EvsSendWindow, gu::to_string(send_window_));
     conf.set(Conf::EvsUserSendWindow, gu::to_string(user_send_window_));
     conf.set(Conf::EvsUseAggregate, gu::to_string(use_aggregate_));
+    conf.set(Conf::EvsAggregateDelay, gu::to_string(aggregate_delay_));
+    conf.set(Conf::EvsAggregateSize, gu::to_string(aggregate_size_));
+    conf.set(Conf::EvsGapRequestPeriod, gu::to_string(gap_request_period_));
     conf.set(Conf::EvsDebugLogMask, gu::to_string(debug_mask_, std::hex));
     conf.set(Conf::EvsInfoLogMask, gu::to_string(info_mask_, std::hex));
     conf.set(Conf::EvsMaxInstallTimeouts, gu::to_string(max_install_timeouts_));
@@ -221,6 +251,8 @@ gcomm::evs::Proto::Proto(gu::Config&    conf,
     conf.set(Conf::EvsAutoEvict, gu::to_string(auto_evict_));
     //
 
+    std::fill(timers_, timers_ + n_timers_, gu::datetime::Date::max());
+
     known_.insert_unique(
         std::make_pair(my_uuid_, Node(*this)));
     self_i_ = known_.begin();
@@ -386,6 +418,37 @@ gcomm::evs::Proto::set_param(const std::string& key, const std::string& val)
         conf_.set(Conf::EvsUseAggregate, gu::to_string(use_aggregate_));
         return true;
     }
+    else if (key == Conf::EvsAggregateDelay)
+    {
+        aggregate_delay_ = check_range(
+            Conf::EvsAggregateDelay,
+            gu::from_string<gu::datetime::Period>(val),
+            gu::datetime::Period(0),
+            gu::datetime::Period::max());
+        conf_.set(Conf::EvsAggregateDelay, gu::to_string(aggregate_delay_));
+        // held messages, if any, will be sent at next timer check
+        return true;
+    }
+    else if (key == Conf::EvsAggregateSize)
+    {
+        aggregate_size_ = check_range(
+            Conf::EvsAggregateSize,
+            gu::from_string<size_t>(val),
+            size_t(0), std::numeric_limits<size_t>::max());
+        conf_.set(Conf::EvsAggregateSize, gu::to_string(aggregate_size_));
+        return true;
+    }
+    else if (key == Conf::EvsGapRequestPeriod)
+    {
+        gap_request_period_ = check_range(
+            Conf::EvsGapRequestPeriod,
+            gu::from_string<gu::datetime::Period>(val),
+            gu::datetime::Period(0),
+            gu::datetime::Period::max());
+        conf_.set(Conf::EvsGapRequestPeriod,
+                  gu::to_string(gap_request_period_));
+        return true;
+    }
     else if (key == Conf::EvsDelayMargin)
     {
         delay_margin_ = gu::from_string<gu::datetime::Period>(val);
@@ -497,8 +560,41 @@ void gcomm::evs::Proto::handle_get_status(gu::Status& status) const
                       gu::to_string(sent_msgs_[Message::T_LEAVE]));
         status.insert("evs_retransmitted", gu::to_string(retrans_msgs_));
         status.insert("evs_recovered", gu::to_string(recovered_msgs_));
+        status.insert("evs_gap_requests", gu::to_string(gap_requests_));
+        status.insert("evs_gap_requests_suppressed",
+                      gu::to_string(gap_requests_suppressed_));
+        status.insert("evs_gaps_filled", gu::to_string(gaps_filled_));
         status.insert("evs_deliv_safe",
                       gu::to_string(delivered_msgs_[O_SAFE]));
+        status.insert("evs_aggregate_avg",
+                      gu::to_string(n_aggregated_s_ > 0 ?
+                                    double(aggregated_s_)/n_aggregated_s_ :
+                                    0.0));
+        status.insert("evs_aggregate_hold", aggregate_hold_.to_string());
+
+        // Per member statistics in format
+        // uuid:safe_lag:retransmitted:gap_requests:last_seen_ms,...
+        // where safe_lag is the number of messages sent by this node
+        // which are not yet known to be received by the member and
+        // last_seen_ms is time since last message from the member.
+        const gu::datetime::Date now(gu::datetime::Date::now());
+        std::ostringstream os;
+        for (NodeList::const_iterator i(current_view_.members().begin());
+             i != current_view_.members().end(); ++i)
+        {
+            NodeMap::const_iterator ni(known_.find(NodeList::key(i)));
+            if (ni == known_.end()) continue;
+            const Node& node(NodeMap::value(ni));
+            const seqno_t safe_lag(
+                node.index() == std::numeric_limits<size_t>::max() ?
+                0 : last_sent_ - input_map_->safe_seq(node.index()));
+            if (os.tellp() > 0) os << ",";
+            os << NodeMap::key(ni).full_str() << ":" << safe_lag
+               << ":" << node.retrans_msgs() << ":" << node.gap_requests()
+               << ":" << (now - node.seen_tstamp()).get_nsecs()
+                / gu::datetime::MSec;
+        }
+        status.insert("evs_peer_stats", os.str());
     }
 }
 
@@ -533,6 +629,9 @@ std::string gcomm::evs::Proto::stats() const
     os << "\n\tsafe deliv hist {" << hs_safe_ << "} ";
     os << "\n\tcaus deliv hist {" << hs_local_causal_ << "} ";
     os << "\n\toutq avg " << double(send_queue_s_)/double(n_send_queue_s_);
+    os << "\n\taggregate avg "
+       << double(aggregated_s_)/double(n_aggregated_s_);
+    os << "\n\taggregate hold {" << aggregate_hold_ << "} ";
     os << "\n\tsent {";
     std::copy(sent_msgs_.begin(), sent_msgs_.end(),
          std::ostream_iterator<long long int>(os, ","));
@@ -555,6 +654,9 @@ std::string gcomm::evs::Proto::stats() const
               std::ostream_iterator<double>(os, ","));
     os << "}\n\tretransmitted " << retrans_msgs_ << " ";
     os << "\n\trecovered " << recovered_msgs_;
+    os << "\n\tgap requests " << gap_requests_
+       << " suppressed " << gap_requests_suppressed_
+       << " filled " << gaps_filled_;
     os << "\n\tdelivered {";
     std::copy(delivered_msgs_.begin(), delivered_msgs_.end(),
               std::ostream_iterator<long long int>(os, ", "));
@@ -573,6 +675,9 @@ void gcomm::evs::Proto::reset_stats()
     safe_deliv_latency_.clear();
     send_queue_s_ = 0;
     n_send_queue_s_ = 0;
+    aggregated_s_ = 0;
+    n_aggregated_s_ = 0;
+    aggregate_hold_.clear();
     last_stats_report_ = gu::datetime::Date::now();
 }
 
@@ -798,18 +903,15 @@ void gcomm::evs::Proto::handle_stats_timer()
 }
 
 
-
-class TimerSelectOp
+void gcomm::evs::Proto::handle_aggregate_timer()
 {
-public:
-    TimerSelectOp(const gcomm::evs::Proto::Timer t_) : t(t_) { }
-    bool operator()(const gcomm::evs::Proto::TimerList::value_type& vt) const
+    if (state() == S_OPERATIONAL)
     {
-        return (gcomm::evs::Proto::TimerList::value(vt) == t);
+        profile_enter(send_user_prof_);
+        send_output(user_send_window_);
+        profile_leave(send_user_prof_);
     }
-private:
-    gcomm::evs::Proto::Timer const t;
-};
+}
 
 
 gu::datetime::Date gcomm::evs::Proto::next_expiration(const Timer t) const
@@ -844,45 +946,42 @@ gu::datetime::Date gcomm::evs::Proto::next_expiration(const Timer t) const
         }
     case T_STATS:
         return (now + stats_report_period_);
-    }
-    gu_throw_fatal;
-}
-
-
-void timer_list_erase_by_type(gcomm::evs::Proto::TimerList& timer_list,
-                              gcomm::evs::Proto::Timer timer)
-{
-    gcomm::evs::Proto::TimerList::iterator i, i_next;
-    for (i = timer_list.begin(); i != timer_list.end(); i = i_next)
-    {
-        i_next = i, ++i_next;
-        if (gcomm::evs::Proto::TimerList::value(i) == timer)
+    case T_AGGREGATE:
+        if (state() == S_OPERATIONAL && output_.empty() == false &&
+            aggregate_start_ != gu::datetime::Date::max())
         {
-            timer_list.erase(i);
+            return (aggregate_start_ + aggregate_delay_);
         }
+        return gu::datetime::Date::max();
     }
+    gu_throw_fatal;
 }
 
+
 void gcomm::evs::Proto::reset_timer(Timer t)
 {
-    timer_list_erase_by_type(timers_, t);
-    timers_.insert(std::make_pair(next_expiration(t), t));
+    timers_[t] = next_expiration(t);
 }
 
 void gcomm::evs::Proto::cancel_timer(Timer t)
 {
-    timer_list_erase_by_type(timers_, t);
+    timers_[t] = gu::datetime::Date::max();
 }
 
 gu::datetime::Date gcomm::evs::Proto::handle_timers()
 {
     gu::datetime::Date now(gu::datetime::Date::now());
 
-    while (timers_.empty() == false &&
-           TimerList::key(timers_.begin()) <= now)
+    while (true)
     {
-        Timer t(TimerList::value(timers_.begin()));
-        timers_.erase(timers_.begin());
+        const gu::datetime::Date* const next(
+            std::min_element(timers_, timers_ + n_timers_));
+        if (*next > now || *next == gu::datetime::Date::max())
+        {
+            break;
+        }
+        Timer t(static_cast<Timer>(next - timers_));
+        timers_[t] = gu::datetime::Date::max();
         switch (t)
         {
         case T_INACTIVITY:
@@ -897,6 +996,9 @@ gu::datetime::Date gcomm::evs::Proto::handle_timers()
         case T_STATS:
             handle_stats_timer();
             break;
+        case T_AGGREGATE:
+            handle_aggregate_timer();
+            break;
         }
         if (state() == S_CLOSED)
         {
@@ -905,12 +1007,12 @@ gu::datetime::Date gcomm::evs::Proto::handle_timers()
         reset_timer(t);
     }
 
-    if (timers_.empty() == true)
+    const gu::datetime::Date ret(next_timer());
+    if (ret == gu::datetime::Date::max())
     {
         evs_log_debug(D_TIMERS) << "no timers set";
-        return gu::datetime::Date::max();
     }
-    return TimerList::key(timers_.begin());
+    return ret;
 }
 
 
@@ -1566,6 +1668,11 @@ int gcomm::evs::Proto::send_user(Datagram& dg,
     }
     gu_trace(pop_header(msg, dg));
     sent_msgs_[Message::T_USER]++;
+    if (order != O_DROP)
+    {
+        ++n_aggregated_s_;
+        aggregated_s_ += n_aggregated;
+    }
 
     if (delivering_ == false)
     {
@@ -1584,10 +1691,14 @@ size_t gcomm::evs::Proto::aggregate_len() const
     std::deque<std::pair<Datagram, ProtoDownMeta> >::const_iterator
         i(output_.begin());
     const Order ord(i->second.order());
+    // aggregated message length is encoded in 16 bits
+    const size_t max_len(std::numeric_limits<uint16_t>::max());
+    if (i->first.len() > max_len) return 0;
     ret += i->first.len() + am.serial_size();
     for (++i; i != output_.end() && i->second.order() == ord; ++i)
     {
-        if (ret + i->first.len() + am.serial_size() <= mtu())
+        if (i->first.len() <= max_len &&
+            ret + i->first.len() + am.serial_size() <= aggregate_size())
         {
             ret += i->first.len() + am.serial_size();
             is_aggregate = true;
@@ -1601,6 +1712,60 @@ size_t gcomm::evs::Proto::aggregate_len() const
     return (is_aggregate == true ? ret : 0);
 }
 
+size_t gcomm::evs::Proto::aggregate_size() const
+{
+    return (aggregate_size_ == 0 ? mtu() : std::min(aggregate_size_, mtu()));
+}
+
+bool gcomm::evs::Proto::is_aggregate_held() const
+{
+    if (aggregate_start_ == gu::datetime::Date::max() ||
+        output_.empty() == true ||
+        aggregate_start_ + aggregate_delay_ <= gu::datetime::Date::now())
+    {
+        return false;
+    }
+
+    // count the same way as aggregate_len()
+    AggregateMessage am;
+    size_t len(0);
+    std::deque<std::pair<Datagram, ProtoDownMeta> >::const_iterator
+        i(output_.begin());
+    for (; i != output_.end() && len < aggregate_size(); ++i)
+    {
+        len += i->first.len() + am.serial_size();
+    }
+    return (len < aggregate_size());
+}
+
+void gcomm::evs::Proto::send_output(const seqno_t win)
+{
+    gcomm_assert(state() == S_OPERATIONAL);
+
+    if (is_aggregate_held() == true)
+    {
+        return;
+    }
+
+    if (aggregate_start_ != gu::datetime::Date::max())
+    {
+        aggregate_hold_.insert(
+            double(gu::datetime::Date::now().get_utc()
+                   - aggregate_start_.get_utc())/gu::datetime::Sec);
+        aggregate_start_ = gu::datetime::Date::max();
+    }
+
+    while (output_.empty() == false)
+    {
+        int err;
+        gu_trace(err = send_user(win));
+        if (err != 0)
+        {
+            break;
+        }
+    }
+}
+
 int gcomm::evs::Proto::send_user(const seqno_t win)
 {
     gcomm_assert(output_.empty() == false);
@@ -2073,6 +2238,7 @@ void gcomm::evs::Proto::resend(const UUID& gap_source, const Range range)
                              << range.lu() << " -> "
                              << range.hs();
 
+    const long long retrans_start(retrans_msgs_);
     seqno_t seq(range.lu());
     while (seq <= range.hs())
     {
@@ -2127,6 +2293,12 @@ void gcomm::evs::Proto::resend(const UUID& gap_source, const Range range)
         seq = seq + msg.seq_range() + 1;
         retrans_msgs_++;
     }
+
+    NodeMap::iterator gi(known_.find(gap_source));
+    if (gi != known_.end())
+    {
+        NodeMap::value(gi).add_retrans_msgs(retrans_msgs_ - retrans_start);
+    }
 }
 
 
@@ -2615,8 +2787,31 @@ int gcomm::evs::Proto::handle_down(Datagram& wb, const ProtoDownMeta& dm)
 
     int ret = 0;
 
-    if (output_.empty() == true)
+    // Hold the message for batching only if messages are coming in
+    // faster than the aggregation delay, otherwise send it right away.
+    const gu::datetime::Date now(gu::datetime::Date::now());
+    const bool batch(use_aggregate_ == true &&
+                     aggregate_delay_ > gu::datetime::Period(0) &&
+                     last_user_down_ + aggregate_delay_ > now);
+    last_user_down_ = now;
+
+    if (output_.empty() == true && batch == true)
     {
+        output_.push_back(std::make_pair(wb, dm));
+        aggregate_start_ = now;
+        if (wb.len() + AggregateMessage().serial_size() >= aggregate_size())
+        {
+            send_output(user_send_window_);
+        }
+        else
+        {
+            reset_timer(T_AGGREGATE);
+            timers_changed_ = true;
+        }
+    }
+    else if (output_.empty() == true)
+    {
+        aggregate_start_ = gu::datetime::Date::max();
         int err;
         err = send_user(wb,
                         dm.user_type(),
@@ -2642,6 +2837,10 @@ int gcomm::evs::Proto::handle_down(Datagram& wb, const ProtoDownMeta& dm)
     else if (output_.size() < max_output_size_)
     {
         output_.push_back(std::make_pair(wb, dm));
+        if (aggregate_start_ != gu::datetime::Date::max())
+        {
+            send_output(user_send_window_);
+        }
     }
     else
     {
@@ -2743,7 +2942,7 @@ void gcomm::evs::Proto::shift_to(const State s, const bool send_j)
         gu_trace(deliver_empty_view());
         cleanup_foreign(im);
         cleanup_views();
-        timers_.clear();
+        std::fill(timers_, timers_ + n_timers_, gu::datetime::Date::max());
         state_ = S_CLOSED;
         break;
     }
@@ -2876,6 +3075,9 @@ void gcomm::evs::Proto::shift_to(const State s, const bool send_j)
             {
                 current_view_.add_member(uuid, NodeMap::value(nmi).segment());
                 NodeMap::value(nmi).set_index(idx++);
+                // seqnos start from scratch in new view
+                NodeMap::value(nmi).set_gap_request(
+                    -1, gu::datetime::Date::zero());
             }
             else
             {
@@ -3021,21 +3223,21 @@ void gcomm::evs::Proto::deliver_finish(const InputMapMsg& msg)
     else
     {
         gu_trace(validate_reg_msg(msg.msg()));
+        const gu::byte_t* const buf(begin(msg.rb()));
+        size_t const buf_len(available(msg.rb()));
         size_t offset(0);
-        while (offset < msg.rb().len())
+        while (offset < buf_len)
         {
             ++delivered_msgs_[msg.msg().order()];
             AggregateMessage am;
-            gu_trace(am.unserialize(&msg.rb().payload()[0],
-                                    msg.rb().payload().size(),
-                                    offset));
+            gu_trace(am.unserialize(buf, buf_len, offset));
             Datagram dg(
                 gu::SharedBuffer(
                     new gu::Buffer(
-                        &msg.rb().payload()[0]
+                        buf
                         + offset
                         + am.serial_size(),
-                        &msg.rb().payload()[0]
+                        buf
                         + offset
                         + am.serial_size()
                         + am.len())));
@@ -3372,8 +3574,13 @@ void gcomm::evs::Proto::handle_user(const UserMessage& msg,
     // Insert only if msg seq is greater or equal than current lowest unseen
     if (msg.seq() >= prev_range.lu())
     {
+        // Received buffer is not modified afterwards, so the message is
+        // kept in input map sharing it instead of copying the payload.
+        // Header space is normally empty here, unless the transport passed
+        // sent datagram through as is.
         Datagram im_dgram(rb, rb.offset());
-        im_dgram.normalize();
+        if (im_dgram.header_len() == 0) im_dgram.trim();
+        else                            im_dgram.normalize();
         gu_trace(range = input_map_->insert(inst.index(), msg, im_dgram));
         if (range.lu() > prev_range.lu())
         {
@@ -3394,18 +3601,40 @@ void gcomm::evs::Proto::handle_user(const UserMessage& msg,
 
     profile_leave(input_map_prof_);
 
+    if ((msg.flags() & Message::F_RETRANS) != 0 &&
+        range.lu() > prev_range.lu())
+    {
+        // retransmission filled the lowest gap in messages from source
+        ++gaps_filled_;
+    }
+
     // Check for missing messages
     if (range.hs()                         >  range.lu() &&
         (msg.flags() & Message::F_RETRANS) == 0                 )
     {
-        evs_log_debug(D_RETRANS) << " requesting retrans from "
-                                 << msg.source() << " "
-                                 << range
-                                 << " due to input map gap, aru "
-                                 << input_map_->aru_seq();
-        profile_enter(send_gap_prof_);
-        gu_trace(send_gap(EVS_CALLER, msg.source(), current_view_.id(), range));
-        profile_leave(send_gap_prof_);
+        const gu::datetime::Date now(gu::datetime::Date::now());
+        // Request again only if the gap is beyond what was requested
+        // last time or the previous request has likely been lost
+        if (range.lu() > inst.gap_request_hs() ||
+            inst.gap_request_tstamp() + gap_request_period_ <= now)
+        {
+            evs_log_debug(D_RETRANS) << " requesting retrans from "
+                                     << msg.source() << " "
+                                     << range
+                                     << " due to input map gap, aru "
+                                     << input_map_->aru_seq();
+            profile_enter(send_gap_prof_);
+            gu_trace(send_gap(EVS_CALLER, msg.source(), current_view_.id(),
+                              range));
+            profile_leave(send_gap_prof_);
+            inst.set_gap_request(range.hs(), now);
+            inst.add_gap_request();
+            ++gap_requests_;
+        }
+        else
+        {
+            ++gap_requests_suppressed_;
+        }
     }
 
     // Seqno range completion and acknowledgement
@@ -3433,15 +3662,7 @@ void gcomm::evs::Proto::handle_user(const UserMessage& msg,
     if (state() == S_OPERATIONAL)
     {
         profile_enter(send_user_prof_);
-        while (output_.empty() == false)
-        {
-            int err;
-            gu_trace(err = send_user(send_window_));
-            if (err != 0)
-            {
-                break;
-            }
-        }
+        send_output(send_window_);
         profile_leave(send_user_prof_);
     }
 
@@ -3625,13 +3846,7 @@ void gcomm::evs::Proto::handle_gap(const GapMessage& msg, NodeMap::iterator ii)
         if (output_.empty() == false)
         {
             profile_enter(send_user_prof_);
-            while (output_.empty() == false)
-            {
-                int err;
-                gu_trace(err = send_user(send_window_));
-                if (err != 0)
-                    break;
-            }
+            send_output(send_window_);
             profile_leave(send_user_prof_);
         }
         else
@@ -3863,17 +4078,16 @@ void gcomm::evs::Proto::asymmetry_elimination()
     // Allow some time to pass from setting install timers to get
     // join messages accumulated.
     const gu::datetime::Date now(gu::datetime::Date::now());
-    TimerList::const_iterator ti(
-        find_if(timers_.begin(), timers_.end(), TimerSelectOp(T_INSTALL)));
+    const gu::datetime::Date& install_expiration(timers_[T_INSTALL]);
 
-    assert(ti != timers_.end());
-    if (ti == timers_.end())
+    assert(install_expiration != gu::datetime::Date::max());
+    if (install_expiration == gu::datetime::Date::max())
     {
         log_warn << "install timer not set in asymmetry_elimination()";
         return;
     }
 
-    if (install_timeout_ - suspect_timeout_ < TimerList::key(ti) - now)
+    if (install_timeout_ - suspect_timeout_ < install_expiration - now)
     {
         // No check yet
         return;
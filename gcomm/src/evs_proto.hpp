@@ -26,6 +26,7 @@
 
 #include "gu_datetime.hpp"
 
+#include <algorithm>
 #include <list>
 #include <deque>
 #include <vector>
@@ -159,7 +160,10 @@ public:
                   size_t n_aggregated = 1);
     size_t mtu() const { return mtu_; }
     size_t aggregate_len() const;
+    size_t aggregate_size() const;
+    bool is_aggregate_held() const;
     int send_user(const seqno_t);
+    void send_output(const seqno_t);
     void complete_user(const seqno_t);
     int send_delegate(Datagram&);
     void send_gap(EVS_CALLER_ARG,
@@ -318,25 +322,46 @@ public:
         T_INACTIVITY,
         T_RETRANS,
         T_INSTALL,
-        T_STATS
+        T_STATS,
+        T_AGGREGATE
     };
+    static const size_t n_timers_ = T_AGGREGATE + 1;
+private:
     /*!
-     * Internal timer list
+     * Internal timer table, expiration time of each timer indexed by
+     * Timer. Each timer can be armed only once, so fixed slots allow
+     * resetting and cancelling timers without searching or allocating.
      */
-    typedef MultiMap<gu::datetime::Date, Timer> TimerList;
-private:
-    TimerList timers_;
+    gu::datetime::Date timers_[n_timers_];
+    // Earliest expiration in timers_
+    gu::datetime::Date next_timer() const
+    {
+        return *std::min_element(timers_, timers_ + n_timers_);
+    }
 public:
     // These need currently to be public for unit tests
     void handle_inactivity_timer();
     void handle_retrans_timer();
     void handle_install_timer();
     void handle_stats_timer();
+    void handle_aggregate_timer();
     gu::datetime::Date next_expiration(const Timer) const;
     void reset_timer(Timer);
     void cancel_timer(Timer);
     gu::datetime::Date handle_timers();
 
+    /*!
+     * Returns true if a timer was armed outside of handle_timers()
+     * since the last call, so that the caller can reschedule its
+     * timer handling. Clears the condition.
+     */
+    bool timers_changed()
+    {
+        bool const ret(timers_changed_);
+        timers_changed_ = false;
+        return ret;
+    }
+
     /*!
      * @brief Flags controlling what debug information is logged if
      *        debug logging is turned on.
@@ -383,18 +408,24 @@ private:
     std::vector<long long int> sent_msgs_;
     long long int retrans_msgs_;
     long long int recovered_msgs_;
+    long long int gap_requests_;            // retransmission requests sent
+    long long int gap_requests_suppressed_; // requests left out as pending
+    long long int gaps_filled_;             // gaps filled by retransmission
     std::vector<long long int> recvd_msgs_;
     std::vector<long long int> delivered_msgs_;
-    prof::Profile send_user_prof_;
-    prof::Profile send_gap_prof_;
-    prof::Profile send_join_prof_;
-    prof::Profile send_install_prof_;
-    prof::Profile send_leave_prof_;
-    prof::Profile consistent_prof_;
-    prof::Profile consensus_prof_;
-    prof::Profile shift_to_prof_;
-    prof::Profile input_map_prof_;
-    prof::Profile delivery_prof_;
+    long long int aggregated_s_;   // user messages sent in data messages
+    long long int n_aggregated_s_; // data messages sent
+    gu::Stats     aggregate_hold_; // time messages were held for batching
+    gu::prof::Profile send_user_prof_;
+    gu::prof::Profile send_gap_prof_;
+    gu::prof::Profile send_join_prof_;
+    gu::prof::Profile send_install_prof_;
+    gu::prof::Profile send_leave_prof_;
+    gu::prof::Profile consistent_prof_;
+    gu::prof::Profile consensus_prof_;
+    gu::prof::Profile shift_to_prof_;
+    gu::prof::Profile input_map_prof_;
+    gu::prof::Profile delivery_prof_;
     bool delivering_;
     UUID my_uuid_;
     SegmentId segment_;
@@ -488,6 +519,14 @@ private:
     uint32_t max_output_size_;
     size_t mtu_;
     bool use_aggregate_;
+    // Batching: max time to hold messages and target aggregate size
+    gu::datetime::Period aggregate_delay_;
+    size_t aggregate_size_;
+    gu::datetime::Date aggregate_start_;
+    gu::datetime::Date last_user_down_;
+    // Minimum period between retransmission requests for same gap
+    gu::datetime::Period gap_request_period_;
+    bool timers_changed_;
     bool self_loopback_;
     State state_;
     int shift_to_rfcnt_;
@@ -68,6 +68,14 @@ namespace gcomm
          */
         static std::string const SocketRecvBufSize;
 
+        /*!
+         * @brief Number of threads to run TCP socket I/O, SSL and message
+         *        checksumming ("socket.io_threads")
+         *
+         * 0 (default) runs socket I/O in the gcomm thread.
+         */
+        static std::string const SocketIoThreads;
+
         /*!
          * @brief GMCast scheme for transport URI ("gmcast")
          */
@@ -75,6 +83,9 @@ namespace gcomm
 
         /*!
          * @brief GMCast protocol version
+         *
+         * All nodes in the group must use the same version. Version 1
+         * allows messages up to Conf::GMCastMaxMessageSize.
          */
         static std::string const GMCastVersion;
 
@@ -125,6 +136,16 @@ namespace gcomm
          */
         static std::string const GMCastMCastTTL;
 
+        /*!
+         * @brief GMCast multicast send rate ("gmcast.mcast_rate")
+         *
+         * Maximum rate in bytes per second at which messages are sent
+         * to multicast group. Messages exceeding the rate are queued
+         * and paced out instead of overflowing receive buffers of
+         * other nodes. Default value 0 means no limit.
+         */
+        static std::string const GMCastMCastRate;
+
         static std::string const GMCastTimeWait;
         static std::string const GMCastPeerTimeout;
 
@@ -155,6 +176,18 @@ namespace gcomm
          */
         static std::string const GMCastIsolate;
 
+        /*!
+         * @brief Maximum message size ("gmcast.max_message_size")
+         *
+         * Maximum size in bytes of messages sent over TCP connections.
+         * Takes effect only with GMCast protocol version 1 or higher and
+         * when multicast is not used, otherwise messages are limited to
+         * the default network MTU of 32KB. Default value is 4MB, upper
+         * limit is 16MB. Note that gcs.max_packet_size must be raised
+         * as well for replication to benefit from larger messages.
+         */
+        static std::string const GMCastMaxMessageSize;
+
         /*!
          * @brief Segment identifier for segmentation.
          */
@@ -296,6 +329,39 @@ namespace gcomm
          */
         static std::string const EvsUseAggregate;
 
+        /*!
+         * @brief EVS aggregation delay ("evs.aggregate_delay")
+         *
+         * Maximum time a user message may be held back in order to
+         * build a fuller aggregate message, e.g. PT0.0005S for 500
+         * microseconds. Messages are held only if the previous message
+         * was sent down less than this period ago, so sparse traffic is
+         * not delayed. Default value PT0S disables batching.
+         */
+        static std::string const EvsAggregateDelay;
+
+        /*!
+         * @brief EVS aggregate size ("evs.aggregate_size")
+         *
+         * Target size in bytes of aggregate messages. Held messages are
+         * sent as soon as this many bytes have been queued. Value 0
+         * (default) means the maximum message size of the transport,
+         * which is also the upper bound for this parameter.
+         */
+        static std::string const EvsAggregateSize;
+
+        /*!
+         * @brief EVS gap request period ("evs.gap_request_period")
+         *
+         * Minimum period between retransmission requests for the same
+         * missing messages from one source. While earlier request is
+         * pending, gaps detected on further messages from the source
+         * are not reported again, so one lost datagram does not cause
+         * a retransmission per subsequently received message. Default
+         * value PT0S requests retransmission on every detected gap.
+         */
+        static std::string const EvsGapRequestPeriod;
+
         /*!
          * @brief Period to generate keepalives for causal messages
          *
@@ -58,6 +58,9 @@ namespace gcomm
 
         uint32_t len() const { return (len_ & len_mask_); }
 
+        /*! maximum message length that can be encoded in the header */
+        static uint32_t max_len() { return len_mask_; }
+
         void set_crc32(uint32_t crc32, checksum_t type)
         {
             assert (CS_CRC32 == type || CS_CRC32C == type);
@@ -156,6 +159,7 @@ namespace gcomm
             header_       (),
             header_offset_(header_size_),
             payload_      (new gu::Buffer()),
+            payload_offset_(0),
             offset_       (0)
         { }
         /*!
@@ -172,6 +176,7 @@ namespace gcomm
             header_       (),
             header_offset_(header_size_),
             payload_      (new gu::Buffer(buf)),
+            payload_offset_(0),
             offset_       (offset)
         {
             assert(offset_ <= payload_->size());
@@ -182,6 +187,7 @@ namespace gcomm
             header_       (),
             header_offset_(header_size_),
             payload_      (buf),
+            payload_offset_(0),
             offset_       (offset)
         {
             assert(offset_ <= payload_->size());
@@ -201,6 +207,7 @@ namespace gcomm
             // header_(dgram.header_),
             header_offset_(dgram.header_offset_),
             payload_(dgram.payload_),
+            payload_offset_(dgram.payload_offset_),
             offset_(off == std::numeric_limits<size_t>::max() ? dgram.offset_ : off)
         {
             assert(offset_ <= dgram.len());
@@ -218,7 +225,8 @@ namespace gcomm
         {
             const gu::SharedBuffer old_payload(payload_);
             payload_ = gu::SharedBuffer(new gu::Buffer);
-            payload_->reserve(header_len() + old_payload->size() - offset_);
+            payload_->reserve(header_len() + old_payload->size()
+                              - payload_offset_ - offset_);
 
             if (header_len() > offset_)
             {
@@ -232,8 +240,32 @@ namespace gcomm
                 offset_ -= header_len();
             }
             header_offset_ = header_size_;
-            payload_->insert(payload_->end(), old_payload->begin() + offset_,
+            payload_->insert(payload_->end(),
+                             old_payload->begin() + payload_offset_ + offset_,
                              old_payload->end());
+            payload_offset_ = 0;
+            offset_ = 0;
+        }
+
+        /*!
+         * @brief Drop data preceding offset without copying payload.
+         *
+         * Unlike normalize() payload buffer stays shared, only the
+         * beginning of payload visible through this datagram moves
+         * forward. Header space is available for pushing new headers
+         * afterwards.
+         */
+        void trim()
+        {
+            if (header_len() > offset_)
+            {
+                header_offset_ += offset_;
+            }
+            else
+            {
+                payload_offset_ += offset_ - header_len();
+                header_offset_   = header_size_;
+            }
             offset_ = 0;
         }
 
@@ -262,9 +294,16 @@ namespace gcomm
             return *payload_;
         }
 
+        /*!
+         * @brief Number of leading payload bytes which are not part
+         *        of the datagram, see trim().
+         */
+        size_t payload_offset() const { return payload_offset_; }
+
         size_t len() const
         {
-            return (header_size_ - header_offset_ + payload_->size());
+            return (header_size_ - header_offset_
+                    + payload_->size() - payload_offset_);
         }
 
         size_t offset() const { return offset_; }
@@ -278,6 +317,7 @@ namespace gcomm
         gu::byte_t          header_[header_size_];
         size_t              header_offset_;
         gu::SharedBuffer    payload_;
+        size_t              payload_offset_;
         size_t              offset_;
     };
 
@@ -289,10 +329,12 @@ namespace gcomm
     inline bool check_cs (const NetHeader& hdr, const Datagram& dg)
     {
         if (hdr.has_crc32c())
-            return (crc32(NetHeader::CS_CRC32C, dg) != hdr.crc32());
+            return (crc32(NetHeader::CS_CRC32C, dg, dg.offset()) !=
+                    hdr.crc32());
 
         if (hdr.has_crc32())
-            return (crc32(NetHeader::CS_CRC32, dg)  != hdr.crc32());
+            return (crc32(NetHeader::CS_CRC32, dg, dg.offset())  !=
+                    hdr.crc32());
 
         return (hdr.crc32() != 0);
     }
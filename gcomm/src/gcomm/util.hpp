@@ -80,13 +80,14 @@ namespace gcomm
     {
         return (dg.offset() < dg.header_len() ?
                 dg.header() + dg.header_offset() + dg.offset() :
-                &dg.payload()[0] + (dg.offset() - dg.header_len()));
+                &dg.payload()[0] + dg.payload_offset()
+                + (dg.offset() - dg.header_len()));
     }
     inline size_t available(const Datagram& dg)
     {
         return (dg.offset() < dg.header_len() ?
                 dg.header_len() - dg.offset() :
-                dg.payload().size() - (dg.offset() - dg.header_len()));
+                dg.len() - dg.offset());
     }
 
 
@@ -71,6 +71,16 @@ gcomm::GMCast::GMCast(Protonet& net, const gu::URI& uri,
                        Conf::GMCastMCastTTL,
                        param<int>(conf_, uri, Conf::GMCastMCastTTL, "1"),
                        1, 256)),
+    mcast_rate_   (check_range(
+                       Conf::GMCastMCastRate,
+                       param<size_t>(conf_, uri, Conf::GMCastMCastRate,
+                                     Defaults::GMCastMCastRate),
+                       size_t(0), std::numeric_limits<size_t>::max())),
+    max_message_size_(
+        check_range(Conf::GMCastMaxMessageSize,
+                    param<size_t>(conf_, uri, Conf::GMCastMaxMessageSize,
+                                  Defaults::GMCastMaxMessageSize),
+                    pnet_.mtu(), size_t(NetHeader::max_len()) + 1)),
     listener_     (0),
     mcast_        (),
     pending_addrs_(),
@@ -80,6 +90,8 @@ gcomm::GMCast::GMCast(Protonet& net, const gu::URI& uri,
     isolate_      (false),
     proto_map_    (new ProtoMap()),
     relay_set_    (),
+    relayed_msgs_ (0),
+    relayed_bytes_(0),
     segment_map_  (),
     self_index_   (std::numeric_limits<size_t>::max()),
     time_wait_    (param<gu::datetime::Period>(
@@ -188,16 +200,25 @@ gcomm::GMCast::GMCast(Protonet& net, const gu::URI& uri,
             uri_string(gu::scheme::udp, mcast_addr_, port)).to_string();
     }
 
+    if (version_ < 1 || mcast_addr_ != "")
+    {
+        // Older peers and UDP can't receive messages over network MTU
+        max_message_size_ = pnet().mtu();
+    }
+
     log_info << self_string() << " listening at " << listen_addr_;
     log_info << self_string() << " multicast: " << mcast_addr_
-             << ", ttl: " << mcast_ttl_;
+             << ", ttl: " << mcast_ttl_
+             << ", rate: " << mcast_rate_;
 
     conf_.set(Conf::GMCastListenAddr, listen_addr_);
     conf_.set(Conf::GMCastMCastAddr, mcast_addr_);
     conf_.set(Conf::GMCastVersion, gu::to_string(version_));
     conf_.set(Conf::GMCastTimeWait, gu::to_string(time_wait_));
     conf_.set(Conf::GMCastMCastTTL, gu::to_string(mcast_ttl_));
+    conf_.set(Conf::GMCastMCastRate, gu::to_string(mcast_rate_));
     conf_.set(Conf::GMCastPeerTimeout, gu::to_string(peer_timeout_));
+    conf_.set(Conf::GMCastMaxMessageSize, gu::to_string(max_message_size_));
     conf_.set(Conf::GMCastSegment, gu::to_string<int>(segment_));
 }
 
@@ -307,6 +328,8 @@ void gcomm::GMCast::connect()
             + gu::URI(listen_addr_).get_host()+'&'
             + gcomm::Socket::OptNonBlocking + "=1&"
             + gcomm::Socket::OptMcastTTL    + '=' + gu::to_string(mcast_ttl_)
+            + '&'
+            + gcomm::Socket::OptMcastRate   + '=' + gu::to_string(mcast_rate_)
             );
 
         mcast_ = pnet().socket(mcast_uri);
@@ -1192,6 +1215,31 @@ void gcomm::GMCast::check_liveness()
 }
 
 
+void gcomm::GMCast::handle_get_status(gu::Status& status) const
+{
+    status.insert("gmcast_relayed_msgs", gu::to_string(relayed_msgs_));
+    status.insert("gmcast_relayed_bytes", gu::to_string(relayed_bytes_));
+
+    // Per peer connection statistics in format
+    // uuid:addr:rtt:rttvar:send_q_len:send_q_bytes:tx_bytes:rx_bytes,...
+    // RTT values are in microseconds and zero if not available.
+    std::ostringstream os;
+    for (ProtoMap::const_iterator i(proto_map_->begin());
+         i != proto_map_->end(); ++i)
+    {
+        const Proto* p(ProtoMap::value(i));
+        if (p->state() != Proto::S_OK) continue;
+        const Socket::Stats st(p->socket()->stats());
+        if (os.tellp() > 0) os << ",";
+        os << p->remote_uuid() << ":" << p->remote_addr()
+           << ":" << st.rtt_ << ":" << st.rttvar_
+           << ":" << st.send_q_len_ << ":" << st.send_q_bytes_
+           << ":" << st.tx_bytes_ << ":" << st.rx_bytes_;
+    }
+    status.insert("gmcast_peer_stats", os.str());
+}
+
+
 gu::datetime::Date gcomm::GMCast::handle_timers()
 {
     const gu::datetime::Date now(gu::datetime::Date::now());
@@ -1207,7 +1255,7 @@ gu::datetime::Date gcomm::GMCast::handle_timers()
 }
 
 
-void send(gcomm::Socket* s, gcomm::Datagram& dg)
+static int send(gcomm::Socket* s, gcomm::Datagram& dg)
 {
     int err;
     if ((err = s->send(dg)) != 0)
@@ -1215,14 +1263,27 @@ void send(gcomm::Socket* s, gcomm::Datagram& dg)
         log_debug << "failed to send to " << s->remote_addr()
                   << ": (" << err << ") " << strerror(err);
     }
+    return err;
+}
+
+
+void gcomm::GMCast::relay_send(Socket* s, Datagram& dg)
+{
+    if (send(s, dg) == 0)
+    {
+        ++relayed_msgs_;
+        relayed_bytes_ += dg.len();
+    }
 }
 
 void gcomm::GMCast::relay(const Message& msg,
                           const Datagram& dg,
                           const void* exclude_id)
 {
+    // Payload is shared with received datagram, only GMCast header
+    // is rewritten in front of it.
     Datagram relay_dg(dg);
-    relay_dg.normalize();
+    relay_dg.trim();
     Message relay_msg(msg);
 
     // reset all relay flags from message to be relayed
@@ -1242,7 +1303,7 @@ void gcomm::GMCast::relay(const Message& msg,
             {
                 if ((*j)->id() != exclude_id)
                 {
-                    send(*j, relay_dg);
+                    relay_send(*j, relay_dg);
                 }
             }
         }
@@ -1258,7 +1319,7 @@ void gcomm::GMCast::relay(const Message& msg,
             for (std::set<Socket*>::iterator ri(relay_set_.begin());
                  ri != relay_set_.end(); ++ri)
             {
-                send(*ri, relay_dg);
+                relay_send(*ri, relay_dg);
             }
             gu_trace(pop_header(relay_msg, relay_dg));
             relay_msg.set_flags(relay_msg.flags() & ~Message::F_RELAY);
@@ -1275,7 +1336,7 @@ void gcomm::GMCast::relay(const Message& msg,
         Segment& segment(segment_map_[segment_]);
         for (Segment::iterator i(segment.begin()); i != segment.end(); ++i)
         {
-            send(*i, relay_dg);
+            relay_send(*i, relay_dg);
         }
     }
     else
@@ -1753,6 +1814,7 @@ bool gcomm::GMCast::set_param(const std::string& key, const std::string& val)
                  key == Conf::GMCastMCastAddr   ||
                  key == Conf::GMCastMCastPort   ||
                  key == Conf::GMCastMCastTTL    ||
+                 key == Conf::GMCastMCastRate   ||
                  key == Conf::GMCastTimeWait    ||
                  key == Conf::GMCastPeerTimeout ||
                  key == Conf::GMCastSegment)
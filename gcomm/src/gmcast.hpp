@@ -20,7 +20,7 @@
 #include <set>
 
 #ifndef GCOMM_GMCAST_MAX_VERSION
-#define GCOMM_GMCAST_MAX_VERSION 0
+#define GCOMM_GMCAST_MAX_VERSION 1
 #endif // GCOMM_GMCAST_MAX_VERSION
 
 namespace gcomm
@@ -42,6 +42,7 @@ namespace gcomm
         // Protolay interface
         void handle_up(const void*, const Datagram&, const ProtoUpMeta&);
         int  handle_down(Datagram&, const ProtoDownMeta&);
+        void handle_get_status(gu::Status& status) const;
         void handle_stable_view(const View& view);
         void handle_evict(const UUID& uuid);
         std::string handle_get_address(const UUID& uuid) const;
@@ -79,7 +80,7 @@ namespace gcomm
 
         size_t mtu() const
         {
-            return pnet_.mtu() - (4 + UUID::serial_size());
+            return max_message_size_ - (4 + UUID::serial_size());
         }
 
         void remove_viewstate_file() const
@@ -177,6 +178,8 @@ namespace gcomm
         std::string       mcast_addr_;
         std::string       bind_ip_;
         int               mcast_ttl_;
+        size_t            mcast_rate_;
+        size_t            max_message_size_;
         Acceptor*         listener_;
         SocketPtr         mcast_;
         AddrList          pending_addrs_;
@@ -187,6 +190,9 @@ namespace gcomm
 
         gmcast::ProtoMap*  proto_map_;
         std::set<Socket*>   relay_set_;
+        // messages and bytes forwarded on behalf of other nodes
+        long long           relayed_msgs_;
+        long long           relayed_bytes_;
 
         typedef std::vector<Socket*> Segment;
         typedef std::map<uint8_t, Segment> SegmentMap;
@@ -228,6 +234,8 @@ namespace gcomm
         void check_liveness();
         void relay(const gmcast::Message& msg, const Datagram& dg,
                    const void* exclude_id);
+        // Send relayed message and account it in relay stats
+        void relay_send(Socket* s, Datagram& dg);
         // Reconnecting
         void reconnect();
 
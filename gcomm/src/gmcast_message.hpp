@@ -322,6 +322,7 @@ public:
 
         switch (version_) {
         case 0:
+        case 1: // same format, version 1 allows larger transport messages
             gu_trace (return read_v0(buf, buflen, off));
         default:
             gu_throw_error(EPROTONOSUPPORT) << "Unsupported/unrecognized gmcast protocol version: " << version_;
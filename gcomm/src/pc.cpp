@@ -40,7 +40,11 @@ int gcomm::PC::handle_down(Datagram& wb, const ProtoDownMeta& dm)
     {
         gu_throw_error(EMSGSIZE);
     }
-    return send_down(wb, dm);
+    int const ret(send_down(wb, dm));
+    // EVS may have armed a timer to send out held messages, make
+    // event loop reschedule its timer handling
+    if (evs_->timers_changed() == true) pnet().interrupt();
+    return ret;
 }
 
 
@@ -46,6 +46,29 @@ public:
     static const std::string OptIfLoop;      /*! socket.if_loop      */
     static const std::string OptCRC32;       /*! socket.crc32        */
     static const std::string OptMcastTTL;    /*! socket.mcast_ttl    */
+    static const std::string OptMcastRate;   /*! socket.mcast_rate   */
+
+    /*!
+     * Socket statistics. Values are maintained by socket implementation
+     * under protonet lock and must be read with the lock held.
+     */
+    struct Stats
+    {
+        Stats() :
+            rtt_       (0),
+            rttvar_    (0),
+            send_q_len_(0),
+            send_q_bytes_(0),
+            tx_bytes_  (0),
+            rx_bytes_  (0)
+        { }
+        long      rtt_;          // round trip time in usecs, 0 if unknown
+        long      rttvar_;       // round trip time variance in usecs
+        size_t    send_q_len_;   // messages waiting to be written
+        size_t    send_q_bytes_; // bytes waiting to be written
+        long long tx_bytes_;     // bytes sent, including headers
+        long long rx_bytes_;     // bytes received, including headers
+    };
 
     Socket(const gu::URI& uri)
         :
@@ -65,6 +88,7 @@ public:
     virtual std::string remote_addr() const = 0;
     virtual State state() const = 0;
     virtual SocketId id() const = 0;
+    virtual Stats stats() const = 0;
 protected:
     const gu::URI uri_;
 };
@@ -24,6 +24,7 @@
 #include "gu_asio.hpp" // gu::ssl_register_params()
 
 #include <stdexcept>
+#include <unistd.h> // usleep()
 #include <vector>
 #include <set>
 
@@ -306,6 +307,79 @@ START_TEST(test_input_map_overwrap)
 END_TEST
 
 
+// Delivery pattern similar to Proto::deliver(): messages are delivered
+// from the beginning of the input map as soon as they become agreed and
+// recovery index is trimmed when safe seq advances.
+START_TEST(test_input_map_deliver)
+{
+    log_info << "START";
+    const size_t  n_nodes[] = { 3, 8, 16 };
+    const seqno_t n_seqnos(20000);
+    ViewId view(V_REG, UUID(1), 1);
+
+    for (size_t n = 0; n < sizeof(n_nodes)/sizeof(n_nodes[0]); ++n)
+    {
+        const size_t nodes(n_nodes[n]);
+        vector<UUID> uuids;
+        for (size_t i = 0; i < nodes; ++i)
+        {
+            uuids.push_back(UUID(static_cast<int32_t>(i + 1)));
+        }
+
+        InputMap im;
+        im.reset(nodes);
+
+        Date start(Date::now());
+        size_t  delivered(0);
+        seqno_t last_seq(-1);
+        size_t  last_idx(0);
+
+        for (seqno_t seq = 0; seq < n_seqnos; ++seq)
+        {
+            // last node lags behind by a few messages
+            for (size_t i = 0; i < nodes; ++i)
+            {
+                const seqno_t s(i + 1 == nodes ? seq - 3 : seq);
+                if (s < 0) continue;
+
+                (void)im.insert(i, UserMessage(0, uuids[i], view, s));
+
+                for (InputMap::iterator ii = im.begin();
+                     ii != im.end() && im.is_agreed(ii) == true;
+                     ii = im.begin())
+                {
+                    const InputMapMsgKey key(InputMapMsgIndex::key(ii));
+                    fail_if(key.seq() < last_seq ||
+                            (key.seq() == last_seq &&
+                             key.index() <= last_idx));
+                    last_seq = key.seq();
+                    last_idx = key.index();
+                    im.erase(ii);
+                    ++delivered;
+                }
+            }
+
+            if (seq % 10 == 0 && im.aru_seq() >= 0)
+            {
+                for (size_t i = 0; i < nodes; ++i)
+                {
+                    im.set_safe_seq(i, im.aru_seq());
+                }
+            }
+        }
+
+        // messages above lagging node seqno are not agreed
+        fail_unless(delivered == nodes*(n_seqnos - 3));
+
+        Date stop(Date::now());
+        double div(double(stop.get_utc() - start.get_utc())/gu::datetime::Sec);
+        log_info << "input map deliver rate with " << nodes << " nodes "
+                 << double(delivered)/div;
+    }
+}
+END_TEST
+
+
 class InputMapInserter
 {
 public:
@@ -1387,6 +1461,165 @@ START_TEST(test_aggreg)
 }
 END_TEST
 
+START_TEST(test_aggreg_delay)
+{
+    log_info << "START (test_aggreg_delay)";
+    const size_t n_nodes(2);
+    PropagationMatrix prop;
+    vector<DummyNode*> dn;
+    const string suspect_timeout("PT1S");
+    const string inactive_timeout("PT3S");
+    const string retrans_period("PT0.1S");
+
+    for (size_t i = 1; i <= n_nodes; ++i)
+    {
+        gu_trace(dn.push_back(
+                     create_dummy_node(i, 0, suspect_timeout,
+                                       inactive_timeout, retrans_period)));
+    }
+
+    for (size_t i = 0; i < n_nodes; ++i)
+    {
+        gu_trace(join_node(&prop, dn[i], i == 0 ? true : false));
+        set_cvi(dn, 0, i, i + 1);
+        gu_trace(prop.propagate_until_cvi(false));
+    }
+
+    Proto* evs0(evs_from_dummy(dn[0]));
+    // test messages are 8 bytes + 4 bytes of aggregate header,
+    // hold messages until three of them have been queued
+    fail_unless(evs0->set_param("evs.aggregate_delay", "PT1M") == true);
+    fail_unless(evs0->set_param("evs.aggregate_size", "36") == true);
+
+    // first message after idle period is sent right away
+    dn[0]->send();
+    fail_unless(evs0->is_output_empty() == true);
+    gu_trace(prop.propagate_until_empty());
+
+    dn[0]->send();
+    dn[0]->send();
+    fail_if(evs0->is_output_empty() == true);
+    gu_trace(prop.propagate_until_empty());
+    fail_if(evs0->is_output_empty() == true);
+
+    // target size reached
+    dn[0]->send();
+    fail_unless(evs0->is_output_empty() == true);
+    gu_trace(prop.propagate_until_empty());
+
+    // held message is sent when delay expires
+    fail_unless(evs0->set_param("evs.aggregate_delay", "PT0.01S") == true);
+    dn[0]->send();
+    dn[0]->send();
+    fail_if(evs0->is_output_empty() == true);
+    usleep(20000);
+    evs0->handle_timers();
+    fail_unless(evs0->is_output_empty() == true);
+
+    gu_trace(prop.propagate_until_empty());
+    gu_trace(check_trace(dn));
+
+    for_each(dn.begin(), dn.end(), DeleteObject());
+}
+END_TEST
+
+
+static std::string evs_status_str(const Proto* evs, const std::string& key)
+{
+    gu::Status status;
+    evs->handle_get_status(status);
+    for (gu::Status::const_iterator i(status.begin()); i != status.end(); ++i)
+    {
+        if (i->first == key) return i->second;
+    }
+    fail("status key %s not found", key.c_str());
+    return "";
+}
+
+static long long evs_status_value(const Proto* evs, const std::string& key)
+{
+    return gu::from_string<long long>(evs_status_str(evs, key));
+}
+
+// Return field of evs_peer_stats entry for peer, fields are
+// 0 - safe lag, 1 - retransmitted, 2 - gap requests, 3 - last seen
+static long long evs_peer_stat(const Proto* evs, const UUID& peer,
+                               size_t field)
+{
+    std::vector<std::string> peers(
+        gu::strsplit(evs_status_str(evs, "evs_peer_stats"), ','));
+    for (size_t i(0); i < peers.size(); ++i)
+    {
+        std::vector<std::string> f(gu::strsplit(peers[i], ':'));
+        fail_unless(f.size() == 5, "invalid peer stats: %s",
+                    peers[i].c_str());
+        if (f[0] == peer.full_str())
+        {
+            return gu::from_string<long long>(f[field + 1]);
+        }
+    }
+    fail("peer %s not found", peer.full_str().c_str());
+    return 0;
+}
+
+START_TEST(test_gap_request_period)
+{
+    log_info << "START (test_gap_request_period)";
+    const size_t n_nodes(2);
+    PropagationMatrix prop;
+    vector<DummyNode*> dn;
+    const string suspect_timeout("PT1S");
+    const string inactive_timeout("PT3S");
+    const string retrans_period("PT0.1S");
+
+    for (size_t i = 1; i <= n_nodes; ++i)
+    {
+        gu_trace(dn.push_back(
+                     create_dummy_node(i, 0, suspect_timeout,
+                                       inactive_timeout, retrans_period)));
+    }
+
+    for (size_t i = 0; i < n_nodes; ++i)
+    {
+        gu_trace(join_node(&prop, dn[i], i == 0 ? true : false));
+        set_cvi(dn, 0, i, i + 1);
+        gu_trace(prop.propagate_until_cvi(false));
+    }
+
+    // let sender run ahead of unacknowledged messages
+    Proto* evs0(evs_from_dummy(dn[0]));
+    fail_unless(evs0->set_param("evs.send_window", "8") == true);
+    fail_unless(evs0->set_param("evs.user_send_window", "8") == true);
+    Proto* evs1(evs_from_dummy(dn[1]));
+    fail_unless(evs1->set_param("evs.gap_request_period", "PT1H") == true);
+
+    // lose one message from node 1 to node 2
+    prop.set_loss(1, 2, 0.);
+    dn[0]->send();
+    gu_trace(prop.propagate_until_empty());
+    prop.set_loss(1, 2, 1.);
+
+    // gap is detected on each of the following messages but
+    // retransmission is requested only once
+    dn[0]->send();
+    dn[0]->send();
+    dn[0]->send();
+    gu_trace(prop.propagate_until_empty());
+
+    fail_unless(evs_status_value(evs1, "evs_gap_requests") == 1);
+    fail_unless(evs_status_value(evs1, "evs_gap_requests_suppressed") >= 1);
+    fail_unless(evs_status_value(evs1, "evs_gaps_filled") == 1);
+    fail_unless(evs_peer_stat(evs1, evs0->uuid(), 2) == 1);
+    fail_unless(evs_peer_stat(evs0, evs1->uuid(), 1) >= 1);
+    fail_unless(evs_peer_stat(evs0, evs1->uuid(), 0) == 0);
+
+    gu_trace(check_trace(dn));
+
+    for_each(dn.begin(), dn.end(), DeleteObject());
+}
+END_TEST
+
+
 START_TEST(test_trac_538)
 {
     gu_conf_self_tstamp_on();
@@ -2084,6 +2317,11 @@ Suite* evs2_suite()
         tcase_set_timeout(tc, 15);
         suite_add_tcase(s, tc);
 
+        tc = tcase_create("test_input_map_deliver");
+        tcase_add_test(tc, test_input_map_deliver);
+        tcase_set_timeout(tc, 15);
+        suite_add_tcase(s, tc);
+
         tc = tcase_create("test_input_map_random_insert");
         tcase_add_test(tc, test_input_map_random_insert);
         suite_add_tcase(s, tc);
@@ -2166,6 +2404,14 @@ Suite* evs2_suite()
         tcase_add_test(tc, test_aggreg);
         suite_add_tcase(s, tc);
 
+        tc = tcase_create("test_aggreg_delay");
+        tcase_add_test(tc, test_aggreg_delay);
+        suite_add_tcase(s, tc);
+
+        tc = tcase_create("test_gap_request_period");
+        tcase_add_test(tc, test_gap_request_period);
+        suite_add_tcase(s, tc);
+
         tc = tcase_create("test_proto_arbitrate");
         tcase_add_test(tc, test_proto_arbitrate);
         suite_add_tcase(s, tc);
@@ -255,6 +255,109 @@ START_TEST(test_gmcast_w_user_messages)
 END_TEST
 
 
+START_TEST(test_gmcast_large_messages)
+{
+    class User : public Toplay
+    {
+        Transport* tp_;
+        Protostack pstack_;
+        size_t     recvd_;
+        size_t     msg_len_;
+        explicit User(const User&);
+        void operator=(User&);
+
+    public:
+
+        User(Protonet& pnet, const std::string& remote_addr, size_t msg_len)
+            :
+            Toplay(pnet.conf()),
+            tp_(Transport::create(
+                    pnet,
+                    "gmcast://" + remote_addr + "?gmcast.group=testgrp"
+                    "&gmcast.version=1&gmcast.time_wait=PT0.5S"
+                    "&gmcast.max_message_size=1048576"
+                    "&gmcast.listen_addr=tcp://127.0.0.1:0")),
+            pstack_(),
+            recvd_(0),
+            msg_len_(msg_len)
+        {
+            pstack_.push_proto(tp_);
+            pstack_.push_proto(this);
+        }
+
+        ~User()
+        {
+            pstack_.pop_proto(this);
+            pstack_.pop_proto(tp_);
+            delete tp_;
+        }
+
+        void send()
+        {
+            Buffer buf(msg_len_, 0xa5);
+            Datagram dg(buf);
+            send_down(dg, ProtoDownMeta());
+        }
+
+        void handle_up(const void* cid, const Datagram& rb,
+                       const ProtoUpMeta& um)
+        {
+            if (rb.len() - rb.offset() != msg_len_)
+            {
+                gu_throw_fatal << "length mismatch: " << rb.len()
+                               << " offset: " << rb.offset();
+            }
+            if (rb.payload()[rb.offset()] != 0xa5 ||
+                rb.payload()[rb.len() - 1] != 0xa5)
+            {
+                gu_throw_fatal << "content mismatch";
+            }
+            recvd_++;
+        }
+
+        size_t recvd() const { return recvd_; }
+
+        Transport& tp() { return *tp_; }
+        Protostack& pstack() { return pstack_; }
+    };
+
+    log_info << "START";
+    gu::Config conf;
+    gu::ssl_register_params(conf);
+    gcomm::Conf::register_params(conf);
+    auto_ptr<Protonet> pnet(Protonet::create(conf));
+
+    // message over network MTU but within gmcast.max_message_size
+    const size_t msg_len(pnet->mtu() * 8);
+
+    User u1(*pnet, "", msg_len);
+    fail_unless(u1.tp().mtu() >= msg_len);
+    pnet->insert(&u1.pstack());
+    u1.tp().connect();
+
+    User u2(*pnet, u1.tp().listen_addr().erase(0, strlen("tcp://")),
+            msg_len);
+    pnet->insert(&u2.pstack());
+    u2.tp().connect();
+
+    while (u1.recvd() < 10 || u2.recvd() < 10)
+    {
+        u1.send();
+        u2.send();
+        pnet->event_loop(Sec/10);
+    }
+
+    pnet->erase(&u2.pstack());
+    pnet->erase(&u1.pstack());
+
+    u1.tp().close();
+    u2.tp().close();
+
+    pnet->event_loop(0);
+}
+END_TEST
+
+
 // not run by default, hard coded port
 START_TEST(test_gmcast_auto_addr)
 {
@@ -443,6 +546,11 @@ Suite* gmcast_suite()
         suite_add_tcase(s, tc);
     }
 
+    tc = tcase_create("test_gmcast_large_messages");
+    tcase_add_test(tc, test_gmcast_large_messages);
+    tcase_set_timeout(tc, 30);
+    suite_add_tcase(s, tc);
+
     tc = tcase_create("test_gmcast_forget");
     tcase_add_test(tc, test_gmcast_forget);
     tcase_set_timeout(tc, 20);
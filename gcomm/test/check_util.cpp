@@ -89,6 +89,31 @@ START_TEST(test_datagram)
         fail_unless(dg16.payload()[i + dg16.offset()] == i + 16);
     }
 
+    // Trim datagram, data before offset is dropped without copying
+    // payload and new header can be pushed in front of remaining data
+    gcomm::Datagram dgtrim(dg16);
+    dgtrim.trim();
+    fail_unless(dgtrim.offset() == 0);
+    fail_unless(dgtrim.payload_offset() == 16);
+    fail_unless(dgtrim.len() == sizeof(b) - 16);
+    fail_unless(&dgtrim.payload()[0] == &dg.payload()[0]);
+    fail_unless(*gcomm::begin(dgtrim) == 16);
+    fail_unless(gcomm::available(dgtrim) == sizeof(b) - 16);
+    fail_unless(gcomm::crc32(gcomm::NetHeader::CS_CRC32C, dgtrim) ==
+                gcomm::crc32(gcomm::NetHeader::CS_CRC32C, dg, 16));
+
+    dgtrim.set_header_offset(dgtrim.header_offset() - 4);
+    memset(dgtrim.header() + dgtrim.header_offset(), 0xff, 4);
+    fail_unless(dgtrim.len() == sizeof(b) - 16 + 4);
+    fail_unless(*gcomm::begin(dgtrim) == 0xff);
+
+    dgtrim.normalize();
+    fail_unless(dgtrim.payload_offset() == 0);
+    fail_unless(dgtrim.len() == sizeof(b) - 16 + 4);
+    fail_unless(dgtrim.payload()[3] == 0xff);
+    fail_unless(dgtrim.payload()[4] == 16);
+    fail_unless(dg.len() == sizeof(b));
+
 #if 0
     // Normalize datagram, all data is moved into payload, data from
     // beginning to offset is discarded. Normalization must not change
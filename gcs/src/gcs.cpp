@@ -14,6 +14,10 @@
 #include <math.h>
 #include <errno.h>
 #include <assert.h>
+#include <time.h>
+
+#include <algorithm>
+#include <sstream>
 
 #include <galerautils.h>
 #include "gu_debug_sync.hpp"
@@ -101,6 +105,25 @@ struct gcs_fc_event
 }
 __attribute__((__packed__));
 
+/** Rate based flow control message, told apart from gcs_fc_event by size.
+ *  All members must understand it, so it is used only when the negotiated
+ *  GCS protocol version is at least GCS_FC_RATE_PROTO_VER. */
+struct gcs_fc_rate_event
+{
+    uint32_t conf_id;     // least significant part of configuraiton seqno
+    uint32_t reserved;
+    uint64_t rate;        // replication rate sender can sustain (byte/s),
+                          // 0 - no limit
+    uint64_t queue_bytes; // sender's slave queue size
+}
+__attribute__((__packed__));
+
+/* lowest GCS protocol version which supports gcs_fc_rate_event */
+static int const GCS_FC_RATE_PROTO_VER = 1;
+
+/* how often sustainable replication rate is reevaluated (ns) */
+static long long const GCS_FC_RATE_PERIOD = 100000000LL;
+
 struct gcs_conn
 {
     long  my_idx;
@@ -129,6 +152,7 @@ struct gcs_conn
     /* A queue for threads waiting for received actions */
     gu_fifo_t*   recv_q;
     ssize_t      recv_q_size;
+    gu::LogHistogram* recv_q_hist;    // recv queue length seen by new actions
     gu_thread_t  recv_thread;
 
     /* Message receiving timeout - absolute date in nanoseconds */
@@ -143,11 +167,24 @@ struct gcs_conn
     long         upper_limit;         // upper slave queue limit
     long         lower_limit;         // lower slave queue limit
     long         fc_offset;           // offset for catchup phase
+    ssize_t      upper_size_limit;    // upper slave queue size limit, bytes
+    ssize_t      lower_size_limit;    // lower slave queue size limit, bytes
+    ssize_t      fc_size_offset;      // offset for catchup phase, bytes
     gcs_conn_state_t max_fc_state;    // maximum state when FC is enabled
     long         stats_fc_sent;       // FC stats counters
     long         stats_fc_received;   //
     gcs_fc_t     stfc; // state transfer FC object
 
+    /* Rate based Flow Control */
+    gcs_fc_rate_t fc_rate;            // pacing of local actions
+    double*      fc_rates;            // rates advertised by members
+    long         fc_rates_len;        //
+    double       fc_rate_adv;         // rate last advertised by this node
+    long long    fc_apply_start;      // apply rate measurement start
+    ssize_t      fc_apply_bytes;      // bytes applied since then
+    ssize_t      fc_total_bytes;      // bytes ordered since last rate change
+    ssize_t      fc_local_bytes;      // of them sent by this node
+
     /* #603, #606 join control */
     bool        volatile need_to_join;
     gcs_seqno_t volatile join_seqno;
@@ -288,11 +325,17 @@ gcs_create (gu_config_t* const conf, gcache_t* const gcache,
     conn->local_act_id = GCS_SEQNO_FIRST;
     conn->global_seqno = 0;
     conn->fc_offset    = 0;
+    conn->fc_size_offset = 0;
     conn->timeout      = GU_TIME_ETERNITY;
     conn->gcache       = gcache;
     conn->max_fc_state = conn->params.sync_donor ?
         GCS_CONN_DONOR : GCS_CONN_JOINED;
 
+    gcs_fc_rate_init (&conn->fc_rate);
+    conn->fc_apply_start = gu_time_monotonic();
+
+    conn->recv_q_hist = new gu::LogHistogram();
+
     gu_mutex_init (&conn->fc_lock, NULL);
 
     return conn; // success
@@ -372,15 +415,26 @@ gcs_send_fc_event (gcs_conn_t* conn, bool stop)
     return gcs_core_send_fc (conn->core, &fc, sizeof(fc));
 }
 
-/* To be called under slave queue lock. Returns true if FC_STOP must be sent */
+/* To be called under slave queue lock. Returns true if slave queue of
+ * queue_size bytes exceeds upper FC limit either in actions or in bytes */
 static inline bool
-gcs_fc_stop_begin (gcs_conn_t* conn)
+gcs_fc_upper_exceeded (const gcs_conn_t* conn, ssize_t const queue_size)
+{
+    return (conn->queue_len > (conn->upper_limit + conn->fc_offset) ||
+            (conn->upper_size_limit > 0 &&
+             queue_size > (conn->upper_size_limit + conn->fc_size_offset)));
+}
+
+/* To be called under slave queue lock. Returns true if FC_STOP must be sent.
+ * act_size is the size of the action about to be queued. */
+static inline bool
+gcs_fc_stop_begin (gcs_conn_t* conn, ssize_t const act_size)
 {
     long err = 0;
 
     bool ret = (conn->stop_count <= 0                                     &&
                 conn->stop_sent  <= 0                                     &&
-                conn->queue_len  >  (conn->upper_limit + conn->fc_offset) &&
+                gcs_fc_upper_exceeded (conn, conn->recv_q_size + act_size)&&
                 conn->state      <= conn->max_fc_state                    &&
                 !(err = gu_mutex_lock (&conn->fc_lock)));
 
@@ -400,8 +454,9 @@ gcs_fc_stop_end (gcs_conn_t* conn)
 {
     long ret;
 
-    gu_debug ("SENDING FC_STOP (local seqno: %lld, fc_offset: %ld)",
-              conn->local_act_id, conn->fc_offset);
+    gu_debug ("SENDING FC_STOP (local seqno: %lld, fc_offset: %ld, "
+              "queue: %zdb)",
+              conn->local_act_id, conn->fc_offset, conn->recv_q_size);
 
     ret = gcs_send_fc_event (conn, GCS_FC_STOP);
 
@@ -421,17 +476,28 @@ gcs_fc_stop_end (gcs_conn_t* conn)
     return ret;
 }
 
-/* To be called under slave queue lock. Returns true if FC_CONT must be sent */
+/* To be called under slave queue lock. Returns true if FC_CONT must be sent.
+ * act_size is the size of the action about to be dequeued. */
 static inline bool
-gcs_fc_cont_begin (gcs_conn_t* conn)
+gcs_fc_cont_begin (gcs_conn_t* conn, ssize_t const act_size)
 {
     long err = 0;
 
     bool queue_decreased = (conn->fc_offset > conn->queue_len &&
                             (conn->fc_offset = conn->queue_len, true));
 
+    ssize_t const queue_size = conn->recv_q_size - act_size;
+
+    bool size_decreased = (conn->fc_size_offset > queue_size &&
+                           (conn->fc_size_offset = queue_size, true));
+
+    bool size_ok = (conn->upper_size_limit <= 0              ||
+                    conn->lower_size_limit >= queue_size     ||
+                    size_decreased);
+
     bool ret = (conn->stop_sent    >  0                                   &&
                 (conn->lower_limit >= conn->queue_len || queue_decreased) &&
+                size_ok                                                   &&
                 conn->state        <= conn->max_fc_state                  &&
                 !(err = gu_mutex_lock (&conn->fc_lock)));
 
@@ -469,6 +535,104 @@ gcs_fc_cont_end (gcs_conn_t* conn)
     return ret;
 }
 
+static inline long
+gcs_send_fc_rate_event (gcs_conn_t* conn, double rate)
+{
+    struct gcs_fc_rate_event fc = {
+        htogl(conn->conf_id),
+        0,
+        htog64(uint64_t(rate)),
+        htog64(uint64_t(conn->recv_q_size))
+    };
+    return gcs_core_send_fc (conn->core, &fc, sizeof(fc));
+}
+
+/* Returns true if rate based flow control is enabled locally and supported
+ * by the whole group. Version of a group which has not been negotiated yet
+ * reads as (gcs_proto_t)-1, so it must be within the known range too. */
+static inline bool
+gcs_fc_rate_enabled (const gcs_conn_t* conn)
+{
+    int const ver = gcs_core_group_protocol_version (conn->core);
+
+    return (conn->params.fc_rate &&
+            ver >= GCS_FC_RATE_PROTO_VER && ver <= GCS_ACT_PROTO_MAX);
+}
+
+/* To be called under slave queue lock. Returns true if rate this node can
+ * sustain has changed and must be advertised */
+static inline bool
+gcs_fc_rate_begin (gcs_conn_t* conn)
+{
+    if (!gcs_fc_rate_enabled (conn)) return false;
+
+    long long const now      = gu_time_monotonic();
+    long long const interval = now - conn->fc_apply_start;
+
+    if (interval < GCS_FC_RATE_PERIOD) return false;
+
+    double const apply_rate = conn->fc_apply_bytes * 1.0e9 / interval;
+
+    conn->fc_apply_start = now;
+    conn->fc_apply_bytes = 0;
+
+    double rate = 0.0;
+
+    if (conn->state <= conn->max_fc_state) {
+        /* throttling band must not collapse with the default fc_factor */
+        long const lower = std::min(conn->lower_limit, conn->upper_limit / 2);
+        rate = gcs_fc_rate_sustainable (apply_rate,
+                                        conn->queue_len - conn->fc_offset,
+                                        lower, conn->upper_limit);
+    }
+
+    /* don't flood the group with insignificant changes */
+    double const adv = conn->fc_rate_adv;
+    if (rate == adv ||
+        (rate > 0.0 && adv > 0.0 && fabs(rate - adv) < 0.1 * adv)) {
+        return false;
+    }
+
+    long const err = gu_mutex_lock (&conn->fc_lock);
+
+    if (gu_unlikely(err)) {
+        gu_fatal ("Mutex lock failed: %d (%s)", err, strerror(err));
+        abort();
+    }
+
+    conn->fc_rate_adv = rate;
+
+    return true;
+}
+
+/* Complement to gcs_fc_rate_begin() */
+static inline long
+gcs_fc_rate_end (gcs_conn_t* conn)
+{
+    long ret;
+
+    if (conn->params.fc_debug) {
+        gu_info ("SENDING FC_RATE: %.0f b/s (queue: %ld, %zdb)",
+                 conn->fc_rate_adv, conn->queue_len, conn->recv_q_size);
+    }
+
+    ret = gcs_send_fc_rate_event (conn, conn->fc_rate_adv);
+
+    if (gu_likely (ret >= 0)) {
+        ret = 0;
+        conn->stats_fc_sent += (conn->fc_rate_adv > 0.0);
+    }
+    else {
+        conn->fc_rate_adv = -1.0; // make sure it is retried
+    }
+
+    gu_mutex_unlock (&conn->fc_lock);
+
+    ret = gcs_check_error (ret, "Failed to send FC_RATE signal");
+
+    return ret;
+}
+
 /* To be called under slave queue lock. Returns true if SYNC must be sent */
 static inline bool
 gcs_send_sync_begin (gcs_conn_t* conn)
@@ -719,8 +883,10 @@ gcs_become_joined (gcs_conn_t* conn)
     /* See also gcs_handle_act_conf () for a case of cluster bootstrapping */
     if (gcs_shift_state (conn, GCS_CONN_JOINED)) {
         conn->fc_offset    = conn->queue_len;
+        conn->fc_size_offset = conn->recv_q_size;
         conn->need_to_join = false;
-        gu_debug("Become joined, FC offset %ld", conn->fc_offset);
+        gu_debug("Become joined, FC offset %ld (%zdb)",
+                 conn->fc_offset, conn->fc_size_offset);
         /* One of the cases when the node can become SYNCED */
         if ((ret = gcs_send_sync (conn))) {
             gu_warn ("Sending SYNC failed: %ld (%s)", ret, strerror (-ret));
@@ -736,8 +902,10 @@ gcs_become_synced (gcs_conn_t* conn)
 {
     gcs_shift_state (conn, GCS_CONN_SYNCED);
     conn->sync_sent = false;
-    gu_debug("Become synced, FC offset %ld", conn->fc_offset);
+    gu_debug("Become synced, FC offset %ld (%zdb)",
+             conn->fc_offset, conn->fc_size_offset);
     conn->fc_offset = 0;
+    conn->fc_size_offset = 0;
 }
 
 /* to be called under protection of both recv_q and fc_lock */
@@ -757,8 +925,119 @@ _set_fc_limits (gcs_conn_t* conn)
     conn->upper_limit = std::min(conn->upper_limit, gu_fifo_max_length(conn->recv_q));
     conn->lower_limit = std::min(conn->lower_limit, gu_fifo_max_length(conn->recv_q));
 
-    gu_info ("Flow-control interval: [%ld, %ld]",
-             conn->lower_limit, conn->upper_limit);
+    /* Size limits are scaled the same way, 0 disables them. */
+    conn->upper_size_limit = conn->params.fc_size_limit * fn + .5;
+    conn->lower_size_limit =
+        conn->upper_size_limit * conn->params.fc_resume_factor + .5;
+
+    if (conn->upper_size_limit > 0) {
+        gu_info ("Flow-control interval: [%ld, %ld], [%zd, %zd] bytes",
+                 conn->lower_limit, conn->upper_limit,
+                 conn->lower_size_limit, conn->upper_size_limit);
+    }
+    else {
+        gu_info ("Flow-control interval: [%ld, %ld]",
+                 conn->lower_limit, conn->upper_limit);
+    }
+}
+
+/* to be called under protection of fc_lock, paces local actions to this
+ * node's part of the lowest rate advertised by group members */
+static void
+_set_fc_rate (gcs_conn_t* conn)
+{
+    double group_rate = 0.0;
+
+    for (long i = 0; i < conn->fc_rates_len; ++i) {
+        double const r = conn->fc_rates[i];
+        if (r > 0.0 && (0.0 == group_rate || r < group_rate)) group_rate = r;
+    }
+
+    /* this node's part of the group traffic, as seen in ordered actions,
+     * but not less than an even share to let idle nodes start sending */
+    double share = 1.0;
+
+    if (!conn->params.fc_master_slave && conn->memb_num > 1) {
+        share = conn->fc_total_bytes > 0 ?
+            double(conn->fc_local_bytes) / conn->fc_total_bytes : 0.0;
+        share = std::max(share, 1.0 / conn->memb_num);
+    }
+
+    conn->fc_total_bytes = 0;
+    conn->fc_local_bytes = 0;
+
+    gcs_fc_rate_set (&conn->fc_rate, group_rate * share);
+
+    if (conn->params.fc_debug) {
+        gu_info ("Flow-control rate: %.0f b/s (group: %.0f b/s, share: %.2f)",
+                 conn->fc_rate.rate, group_rate, share);
+    }
+}
+
+/*! Handles rate based flow control events */
+static void
+gcs_handle_flow_control_rate (gcs_conn_t*                     conn,
+                              const struct gcs_fc_rate_event* fc,
+                              int                             sender_idx)
+{
+    if (gtohl(fc->conf_id) != (uint32_t)conn->conf_id) {
+        // obsolete fc request
+        return;
+    }
+
+    double const rate = gtoh64(fc->rate);
+
+    if (gu_mutex_lock (&conn->fc_lock)) {
+        gu_fatal ("Failed to lock mutex.");
+        abort();
+    }
+
+    if (sender_idx >= 0 && sender_idx < conn->fc_rates_len) {
+        conn->stats_fc_received +=
+            (rate > 0.0 && 0.0 == conn->fc_rates[sender_idx]);
+        conn->fc_rates[sender_idx] = rate;
+        _set_fc_rate (conn);
+    }
+
+    gu_mutex_unlock (&conn->fc_lock);
+}
+
+/*! Sleeps as required by rate based flow control before sending action.
+ *  Sleep is cut short if the rate changes meanwhile. */
+static void
+gcs_fc_rate_pace (gcs_conn_t* conn, size_t act_size)
+{
+    if (!gcs_fc_rate_enabled (conn)) return;
+
+    if (gu_mutex_lock (&conn->fc_lock)) {
+        gu_fatal ("Failed to lock mutex.");
+        abort();
+    }
+
+    long long       pause = gcs_fc_rate_process (&conn->fc_rate, act_size);
+    long long const start = conn->fc_rate.start;
+
+    gu_mutex_unlock (&conn->fc_lock);
+
+    while (pause > 0) {
+        long long const slice = std::min(pause, GCS_FC_RATE_PERIOD);
+        struct timespec ts = { time_t(slice / 1000000000LL),
+                               long(slice % 1000000000LL) };
+        nanosleep (&ts, NULL);
+        pause -= slice;
+
+        if (gu_mutex_lock (&conn->fc_lock)) {
+            gu_fatal ("Failed to lock mutex.");
+            abort();
+        }
+
+        bool const changed = (start != conn->fc_rate.start ||
+                              conn->state > GCS_CONN_OPEN);
+
+        gu_mutex_unlock (&conn->fc_lock);
+
+        if (changed) break;
+    }
 }
 
 /*! Handles flow control events
@@ -841,6 +1120,27 @@ gcs_handle_act_conf (gcs_conn_t* conn, const void* action)
 
             _set_fc_limits (conn);
 
+            /* rates advertised in previous configuration are obsolete */
+            if (conn->fc_rates_len != conf->memb_num) {
+                double* const rates = (double*)gu_realloc (conn->fc_rates,
+                                          conf->memb_num * sizeof(double));
+                if (rates || 0 == conf->memb_num) {
+                    conn->fc_rates     = rates;
+                    conn->fc_rates_len = conf->memb_num;
+                }
+                else {
+                    gu_fatal ("Failed to allocate flow control rates.");
+                    abort();
+                }
+            }
+            for (long i = 0; i < conn->fc_rates_len; ++i) {
+                conn->fc_rates[i] = 0.0;
+            }
+            conn->fc_rate_adv    = 0.0;
+            conn->fc_total_bytes = 0;
+            conn->fc_local_bytes = 0;
+            gcs_fc_rate_set (&conn->fc_rate, 0.0);
+
             gu_mutex_unlock (&conn->fc_lock);
         }
         else {
@@ -1006,8 +1306,20 @@ gcs_handle_actions (gcs_conn_t*          conn,
 
     switch (rcvd->act.type) {
     case GCS_ACT_FLOW:
-        assert (sizeof(struct gcs_fc_event) == rcvd->act.buf_len);
-        gcs_handle_flow_control (conn, (const gcs_fc_event*)rcvd->act.buf);
+        if (sizeof(struct gcs_fc_event) == rcvd->act.buf_len) {
+            gcs_handle_flow_control (conn, (const gcs_fc_event*)rcvd->act.buf);
+        }
+        else if (sizeof(struct gcs_fc_rate_event) == rcvd->act.buf_len &&
+                 gcs_core_group_protocol_version (conn->core) >=
+                 GCS_FC_RATE_PROTO_VER) {
+            gcs_handle_flow_control_rate (conn,
+                (const gcs_fc_rate_event*)rcvd->act.buf, rcvd->sender_idx);
+        }
+        else {
+            gu_warn ("Discarding unsupported flow control message of size "
+                     "%zd from member %d", rcvd->act.buf_len,
+                     rcvd->sender_idx);
+        }
         break;
     case GCS_ACT_CONF:
         gcs_handle_act_conf (conn, rcvd->act.buf);
@@ -1038,6 +1350,7 @@ gcs_handle_actions (gcs_conn_t*          conn,
 static inline void
 GCS_FIFO_PUSH_TAIL (gcs_conn_t* conn, ssize_t size)
 {
+    conn->recv_q_hist->insert(gu_fifo_length(conn->recv_q));
     conn->recv_q_size += size;
     gu_fifo_push_tail(conn->recv_q);
 }
@@ -1253,6 +1566,12 @@ static void *gcs_recv_thread (void *arg)
             this_act_id = gu_atomic_fetch_and_add(&conn->local_act_id, 1);
         }
 
+        if (GCS_ACT_TORDERED == rcvd.act.type) {
+            /* for rate based flow control share estimation */
+            conn->fc_total_bytes += rcvd.act.buf_len;
+            if (NULL != rcvd.local) conn->fc_local_bytes += rcvd.act.buf_len;
+        }
+
         if (NULL != rcvd.local                                          &&
             (repl_act_ptr = (struct gcs_repl_act**)
              gcs_fifo_lite_get_head (conn->repl_q))                     &&
@@ -1289,7 +1608,8 @@ static void *gcs_recv_thread (void *arg)
                 recv_act->local_id = this_act_id;
 
                 conn->queue_len = gu_fifo_length (conn->recv_q) + 1;
-                bool send_stop  = gcs_fc_stop_begin (conn);
+                bool send_stop  = gcs_fc_stop_begin (conn, rcvd.act.buf_len);
+                bool send_rate  = !send_stop && gcs_fc_rate_begin (conn);
 
                 // release queue
                 GCS_FIFO_PUSH_TAIL (conn, rcvd.act.buf_len);
@@ -1305,6 +1625,12 @@ static void *gcs_recv_thread (void *arg)
                               ret, strerror(-ret));
                     break;
                 }
+
+                if (gu_unlikely(send_rate) && (ret = gcs_fc_rate_end(conn))) {
+                    gu_error ("gcs_fc_rate() returned %d: %s",
+                              ret, strerror(-ret));
+                    break;
+                }
             }
             else {
                 assert (GCS_CONN_CLOSED == conn->state);
@@ -1503,6 +1829,8 @@ long gcs_destroy (gcs_conn_t *conn)
 
     /* This must not last for long */
     while (gu_mutex_destroy (&conn->fc_lock));
+    gu_free (conn->fc_rates);
+    delete conn->recv_q_hist;
 
     _cleanup_params (conn);
 
@@ -1525,6 +1853,8 @@ long gcs_sendv (gcs_conn_t*          const conn,
     /*! locking connection here to avoid race with gcs_close()
      *  @note: gcs_repl() and gcs_recv() cannot lock connection
      *         because they block indefinitely waiting for actions */
+    if (GCS_ACT_TORDERED == act_type) gcs_fc_rate_pace (conn, act_size);
+
     gu_cond_t tmp_cond;
     gu_cond_init (&tmp_cond, NULL);
 
@@ -1571,6 +1901,8 @@ long gcs_replv (gcs_conn_t*          const conn,      //!<in
     act->seqno_l = GCS_SEQNO_ILL;
     act->seqno_g = GCS_SEQNO_ILL;
 
+    if (GCS_ACT_TORDERED == act->type) gcs_fc_rate_pace (conn, act->size);
+
     /* This is good - we don't have to do a copy because we wait */
     struct gcs_repl_act repl_act(act_in, act);
 
@@ -1817,8 +2149,11 @@ long gcs_recv (gcs_conn_t*        conn,
     if ((recv_act = (struct gcs_recv_act*)gu_fifo_get_head (conn->recv_q, &err)))
     {
         conn->queue_len = gu_fifo_length (conn->recv_q) - 1;
-        bool send_cont  = gcs_fc_cont_begin   (conn);
+        conn->fc_apply_bytes += recv_act->rcvd.act.buf_len;
+        bool send_cont  = gcs_fc_cont_begin   (conn,
+                                               recv_act->rcvd.act.buf_len);
         bool send_sync  = gcs_send_sync_begin (conn);
+        bool send_rate  = !send_cont && gcs_fc_rate_begin (conn);
 
         action->buf     = (void*)recv_act->rcvd.act.buf;
         action->size    = recv_act->rcvd.act.buf_len;
@@ -1862,6 +2197,11 @@ long gcs_recv (gcs_conn_t*        conn,
                      err, strerror(-err));
         }
 
+        if (gu_unlikely(send_rate) && (err = gcs_fc_rate_end (conn))) {
+            gu_warn ("Failed to send FC_RATE message: %d (%s). "
+                     "Will try later.", err, strerror(-err));
+        }
+
         return action->size;
     }
     else {
@@ -1907,7 +2247,8 @@ long
 gcs_wait (gcs_conn_t* conn)
 {
     if (gu_likely(GCS_CONN_SYNCED == conn->state)) {
-       return (conn->stop_count > 0 || (conn->queue_len > conn->upper_limit));
+       return (conn->stop_count > 0 || gcs_fc_upper_exceeded (conn,
+                                                              conn->recv_q_size));
     }
     else {
         switch (conn->state) {
@@ -2004,12 +2345,23 @@ gcs_get_stats (gcs_conn_t* conn, struct gcs_stats* stats)
 
     stats->fc_lower_limit = conn->lower_limit;
     stats->fc_upper_limit = conn->upper_limit;
+    stats->fc_lower_size_limit = conn->lower_size_limit;
+    stats->fc_upper_size_limit = conn->upper_size_limit;
+
+    gu_mutex_lock (&conn->fc_lock);
+    stats->fc_rate     = conn->fc_rate.rate;
+    stats->fc_paced_ns = conn->fc_rate.paced_ns;
+    gu_mutex_unlock (&conn->fc_lock);
+
+    long long causal_calls;
+    gcs_core_caused_stats (conn->core, &causal_calls, &stats->causal_msgs);
 }
 
 void
 gcs_flush_stats(gcs_conn_t* conn)
 {
     gu_fifo_stats_flush(conn->recv_q);
+    conn->recv_q_hist->clear();
     gcs_sm_stats_flush (conn->sm);
     conn->stats_fc_sent     = 0;
     conn->stats_fc_received = 0;
@@ -2024,6 +2376,24 @@ void gcs_get_status(gcs_conn_t* conn, gu::Status& status)
 #endif
         gcs_core_get_status(conn->core, status);
     }
+
+    /* distributions since last stats flush as "p50/p99/p999" */
+    gu::LogHistogram::Snapshot recv_q, send_q, paused;
+
+    conn->recv_q_hist->snapshot(recv_q);
+    gcs_sm_stats_hist (conn->sm, &send_q, &paused);
+
+    std::ostringstream os;
+    recv_q.print_percentiles(os);
+    status.insert("local_recv_queue_pct", os.str());
+
+    os.str("");
+    send_q.print_percentiles(os);
+    status.insert("local_send_queue_pct", os.str());
+
+    os.str("");
+    paused.print_percentiles(os);
+    status.insert("flow_control_paused_ns_pct", os.str());
 }
 
 static long
@@ -2059,6 +2429,39 @@ _set_fc_limit (gcs_conn_t* conn, const char* value)
     }
 }
 
+static long
+_set_fc_size_limit (gcs_conn_t* conn, const char* value)
+{
+    long long limit;
+    const char* const endptr = gu_str2ll(value, &limit);
+
+    if (limit >= 0LL && *endptr == '\0') {
+
+        if (limit > SSIZE_MAX) limit = SSIZE_MAX;
+
+        gu_fifo_lock(conn->recv_q);
+        {
+            if (!gu_mutex_lock (&conn->fc_lock)) {
+                conn->params.fc_size_limit = limit;
+                _set_fc_limits (conn);
+                gu_config_set_int64 (conn->config, GCS_PARAMS_FC_SIZE_LIMIT,
+                                     conn->params.fc_size_limit);
+                gu_mutex_unlock (&conn->fc_lock);
+            }
+            else {
+                gu_fatal ("Failed to lock mutex.");
+                abort();
+            }
+        }
+        gu_fifo_release (conn->recv_q);
+
+        return 0;
+    }
+    else {
+        return -EINVAL;
+    }
+}
+
 static long
 _set_fc_factor (gcs_conn_t* conn, const char* value)
 {
@@ -2232,6 +2635,9 @@ long gcs_param_set  (gcs_conn_t* conn, const char* key, const char *value)
     if (!strcmp (key, GCS_PARAMS_FC_LIMIT)) {
         return _set_fc_limit (conn, value);
     }
+    else if (!strcmp (key, GCS_PARAMS_FC_SIZE_LIMIT)) {
+        return _set_fc_size_limit (conn, value);
+    }
     else if (!strcmp (key, GCS_PARAMS_FC_FACTOR)) {
         return _set_fc_factor (conn, value);
     }
@@ -442,6 +442,11 @@ struct gcs_stats
     int       send_q_len_min; //! minimum send queue length
     long      fc_lower_limit; //! Flow-control interval lower limit
     long      fc_upper_limit; //! Flow-control interval upper limit
+    ssize_t   fc_lower_size_limit; //! Flow-control interval in bytes,
+    ssize_t   fc_upper_size_limit; //! 0 if not limited by size
+    double    fc_rate;        //! rate based FC send rate limit, 0 - none
+    long long fc_paced_ns;    //! total nanoseconds senders paced by rate FC
+    long long causal_msgs;    //! causal messages sent for gcs_caused() calls
     gcs_backend_stats_t backend_stats; //! backend stats.
 };
 
@@ -79,6 +79,16 @@ struct gcs_core
     size_t          msg_size;
     gcs_backend_t   backend;   // message IO context
 
+    /* causal reads: callers arriving while a causal message is in flight
+     * share the next one instead of sending a message each */
+    gu_mutex_t      causal_lock;
+    gu_cond_t       causal_cond;
+    gcs_seqno_t     causal_seqno;     // result of the last completed round
+    long long       causal_sent;      // number of causal messages sent
+    long long       causal_done;      // number of causal messages received
+    bool            causal_in_flight;
+    long long       causal_calls;     // number of gcs_core_caused() calls
+
 #ifdef GCS_CORE_TESTING
     gu_lock_step_t  ls;        // to lock-step in unit tests
     gu_uuid_t state_uuid;
@@ -94,14 +104,7 @@ typedef struct core_act
 }
 core_act_t;
 
-typedef struct causal_act
-{
-    gcs_seqno_t* act_id;
-    gu_mutex_t*  mtx;
-    gu_cond_t*   cond;
-} causal_act_t;
-
-static int const GCS_PROTO_MAX = 0;
+static int const GCS_PROTO_MAX = 1;
 
 gcs_core_t*
 gcs_core_create (gu_config_t* const conf,
@@ -135,6 +138,8 @@ gcs_core_create (gu_config_t* const conf,
                                                    sizeof (core_act_t));
                 if (core->fifo) {
                     gu_mutex_init  (&core->send_lock, NULL);
+                    gu_mutex_init  (&core->causal_lock, NULL);
+                    gu_cond_init   (&core->causal_cond, NULL);
                     core->proto_ver = -1; // shall be bumped in gcs_group_act_conf()
                     gcs_group_init (&core->group, cache, node_name, inc_addr,
                                     GCS_PROTO_MAX, repl_proto_ver,
@@ -699,6 +704,24 @@ core_handle_last_msg (gcs_core_t*          core,
     return 0;
 }
 
+/*!
+ * Causal message in flight may never be delivered after configuration
+ * change or close, so its waiters are released with error. Those who wait
+ * for the next round will send a message of their own.
+ */
+static void
+core_causal_abort (gcs_core_t* core, gcs_seqno_t const err)
+{
+    gu_mutex_lock (&core->causal_lock);
+    if (core->causal_in_flight) {
+        core->causal_in_flight = false;
+        core->causal_done      = core->causal_sent;
+        core->causal_seqno     = err;
+        gu_cond_broadcast (&core->causal_cond);
+    }
+    gu_mutex_unlock (&core->causal_lock);
+}
+
 /*!
  * Helper for gcs_core_recv(). Handles GCS_MSG_COMPONENT.
  *
@@ -719,6 +742,8 @@ core_handle_comp_msg (gcs_core_t*          core,
         return 0;
     }
 
+    core_causal_abort (core, -EAGAIN);
+
     if (gu_mutex_lock (&core->send_lock)) abort();
     ret = gcs_group_handle_comp_msg (group, (const gcs_comp_msg_t*)msg->buf);
 
@@ -1015,11 +1040,11 @@ core_msg_to_action (gcs_core_t*          core,
 static long core_msg_causal(gcs_core_t* conn,
                             struct gcs_recv_msg* msg)
 {
-    causal_act_t* act;
-    if (gu_unlikely(msg->size != sizeof(*act)))
+    long long round;
+    if (gu_unlikely(msg->size != sizeof(round)))
     {
         gu_error("invalid causal act len %ld, expected %ld",
-                 msg->size, sizeof(*act));
+                 msg->size, sizeof(round));
         return -EPROTO;
     }
 
@@ -1027,11 +1052,19 @@ static long core_msg_causal(gcs_core_t* conn,
         GCS_GROUP_PRIMARY == conn->group.state ?
         conn->group.act_id_ : GCS_SEQNO_ILL;
 
-    act = (causal_act_t*)msg->buf;
-    gu_mutex_lock(act->mtx);
-    *act->act_id = causal_seqno;
-    gu_cond_signal(act->cond);
-    gu_mutex_unlock(act->mtx);
+    /* causal messages are delivered only to the sender, no byte order
+     * conversion needed */
+    memcpy(&round, msg->buf, sizeof(round));
+
+    gu_mutex_lock(&conn->causal_lock);
+    if (round > conn->causal_done)
+    {
+        conn->causal_done  = round;
+        conn->causal_seqno = causal_seqno;
+    }
+    if (round == conn->causal_sent) conn->causal_in_flight = false;
+    gu_cond_broadcast(&conn->causal_cond);
+    gu_mutex_unlock(&conn->causal_lock);
     return msg->size;
 }
 
@@ -1176,6 +1209,8 @@ long gcs_core_close (gcs_core_t* core)
 
     gu_mutex_unlock (&core->send_lock);
 
+    core_causal_abort (core, -ECONNABORTED);
+
     return ret;
 }
 
@@ -1206,6 +1241,8 @@ long gcs_core_destroy (gcs_core_t* core)
 
     /* after that we must be able to destroy mutexes */
     while (gu_mutex_destroy (&core->send_lock));
+    while (gu_mutex_destroy (&core->causal_lock));
+    gu_cond_destroy (&core->causal_cond);
     /* now noone will interfere */
     while ((tmp = (core_act_t*)gcs_fifo_lite_get_head (core->fifo))) {
         // whatever is in tmp.action is allocated by app., just forget it.
@@ -1333,38 +1370,67 @@ gcs_core_send_fc (gcs_core_t* core, const void* fc, size_t fc_size)
     return ret;
 }
 
+/*
+ * Causal message sent before the call may have been delivered before
+ * actions the caller must see, so caller waits for the first message sent
+ * after its arrival. While a message is in flight, all arriving callers
+ * share the next one which is sent by whoever gets to it first.
+ */
 gcs_seqno_t
 gcs_core_caused(gcs_core_t* core)
 {
-    long         ret;
-    gcs_seqno_t  act_id = GCS_SEQNO_ILL;
-    gu_mutex_t   mtx;
-    gu_cond_t    cond;
-    causal_act_t act = {&act_id, &mtx, &cond};
-
-    gu_mutex_init (&mtx, NULL);
-    gu_cond_init  (&cond, NULL);
-    gu_mutex_lock (&mtx);
-    {
-        ret = core_msg_send_retry (core, &act, sizeof(act), GCS_MSG_CAUSAL);
+    gcs_seqno_t act_id = GCS_SEQNO_ILL;
+
+    gu_mutex_lock (&core->causal_lock);
 
-        if (ret == sizeof(act))
+    long long const target = core->causal_sent + 1;
+    core->causal_calls++;
+
+    while (core->causal_done < target)
+    {
+        if (!core->causal_in_flight)
         {
-            gu_cond_wait (&cond, &mtx);
+            long long const round = ++core->causal_sent;
+            core->causal_in_flight = true;
+            gu_mutex_unlock (&core->causal_lock);
+
+            long const ret = core_msg_send_retry (core, &round, sizeof(round),
+                                                  GCS_MSG_CAUSAL);
+
+            gu_mutex_lock (&core->causal_lock);
+
+            if (ret != sizeof(round))
+            {
+                assert (ret < 0);
+                /* let waiters retry with a message of their own */
+                core->causal_in_flight = false;
+                gu_cond_broadcast (&core->causal_cond);
+                gu_mutex_unlock (&core->causal_lock);
+                return ret;
+            }
         }
         else
         {
-            assert (ret < 0);
-            act_id = ret;
+            gu_cond_wait (&core->causal_cond, &core->causal_lock);
         }
     }
-    gu_mutex_unlock  (&mtx);
-    gu_mutex_destroy (&mtx);
-    gu_cond_destroy  (&cond);
+
+    act_id = core->causal_seqno;
+
+    gu_mutex_unlock (&core->causal_lock);
 
     return act_id;
 }
 
+void
+gcs_core_caused_stats (gcs_core_t* core, long long* calls, long long* msgs)
+{
+    gu_mutex_lock (&core->causal_lock);
+    *calls = core->causal_calls;
+    *msgs  = core->causal_sent;
+    gu_mutex_unlock (&core->causal_lock);
+}
+
 long
 gcs_core_param_set (gcs_core_t* core, const char* key, const char* value)
 {
@@ -158,6 +158,10 @@ gcs_core_send_fc (gcs_core_t* core, const void* fc, size_t fc_size);
 extern gcs_seqno_t
 gcs_core_caused(gcs_core_t* core);
 
+/* number of gcs_core_caused() calls and causal messages sent for them */
+extern void
+gcs_core_caused_stats (gcs_core_t* core, long long* calls, long long* msgs);
+
 extern long
 gcs_core_param_set (gcs_core_t* core, const char* key, const char* value);
 
@@ -12,6 +12,8 @@
 #include <galerautils.h>
 #include <string.h>
 
+#include <algorithm>
+
 double const gcs_fc_hard_limit_fix = 0.9; //! allow for some overhead
 
 static double const min_sleep = 0.001; //! minimum sleep period (s)
@@ -204,3 +206,71 @@ gcs_fc_process (gcs_fc_t* fc, ssize_t act_size)
 }
 
 void gcs_fc_debug (gcs_fc_t* fc, long debug_level) { fc->debug = debug_level; }
+
+/*! Pacing credit is not accumulated for longer than that (s) */
+static double const max_rate_interval = 1.0;
+
+/*! Lowest rate advertised when applying stalls completely (byte/s) */
+static double const min_rate = 1024.0;
+
+void
+gcs_fc_rate_init (gcs_fc_rate_t* const fc)
+{
+    memset (fc, 0, sizeof(*fc));
+}
+
+void
+gcs_fc_rate_set (gcs_fc_rate_t* const fc, double const rate)
+{
+    assert (rate >= 0.0);
+
+    fc->rate  = rate;
+    fc->start = gu_time_monotonic();
+    fc->sent  = 0;
+}
+
+long long
+gcs_fc_rate_process (gcs_fc_rate_t* const fc, ssize_t const act_size)
+{
+    if (0.0 == fc->rate) return 0;
+
+    long long const now = gu_time_monotonic();
+    double interval = (now - fc->start) * 1.0e-9;
+
+    if (interval > max_rate_interval) {
+        /* sender was idle, don't let it burst */
+        fc->start = now;
+        fc->sent  = 0;
+        interval  = 0.0;
+    }
+
+    fc->sent += act_size;
+
+    double const sleep = (double)fc->sent / fc->rate - interval;
+
+    if (gu_likely(sleep < min_sleep)) return 0;
+
+    long long const ret = 1000000000LL * sleep;
+    fc->paced_ns += ret;
+
+    return ret;
+}
+
+/*
+ * Below the lower limit no pacing is needed. Between the limits the rate
+ * goes linearly from the measured apply rate, which keeps the queue length
+ * steady, down to half of it, which makes the queue drain.
+ */
+double
+gcs_fc_rate_sustainable (double const apply_rate, long const queue_len,
+                         long const lower, long const upper)
+{
+    if (queue_len <= lower) return 0.0;
+
+    double const excess = upper > lower ?
+        (double)(queue_len - lower) / (upper - lower) : 1.0;
+
+    double const rate = apply_rate * (1.0 - 0.5 * std::min(excess, 1.0));
+
+    return std::max(rate, min_rate);
+}
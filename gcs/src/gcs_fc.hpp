@@ -56,4 +56,39 @@ gcs_fc_process (gcs_fc_t* fc, ssize_t act_size);
 extern void
 gcs_fc_debug (gcs_fc_t* fc, long debug_level);
 
+/*! Send rate limiter for rate based flow control: instead of stopping
+ *  replication completely senders are paced to the rate the slowest
+ *  group member can sustain. */
+typedef struct gcs_fc_rate
+{
+    double    rate;     // allowed send rate (byte/s), 0 - unlimited
+    long long start;    // beginning of the time interval (nanosec, monotonic)
+    ssize_t   sent;     // bytes sent since the beginning of the interval
+    long long paced_ns; // total nanoseconds senders were told to sleep
+}
+gcs_fc_rate_t;
+
+/*! Initializes rate limiter with unlimited rate */
+extern void
+gcs_fc_rate_init (gcs_fc_rate_t* fc);
+
+/*! Sets new allowed send rate, 0 to disable pacing */
+extern void
+gcs_fc_rate_set (gcs_fc_rate_t* fc, double rate);
+
+/*! Processes a new action to be sent.
+ *  @return nanoseconds to sleep before sending */
+extern long long
+gcs_fc_rate_process (gcs_fc_rate_t* fc, ssize_t act_size);
+
+/*! Computes the group replication rate this node can sustain.
+ *  @param apply_rate measured rate of applying actions (byte/s)
+ *  @param queue_len  slave queue length
+ *  @param lower      queue length at which throttling begins
+ *  @param upper      queue length at which throttling is the strongest
+ *  @return sustainable rate (byte/s) or 0 if no limit is needed */
+extern double
+gcs_fc_rate_sustainable (double apply_rate, long queue_len,
+                         long lower, long upper);
+
 #endif /* _gcs_fc_h_ */
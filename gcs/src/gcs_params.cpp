@@ -12,7 +12,9 @@
 
 const char* const GCS_PARAMS_FC_FACTOR         = "gcs.fc_factor";
 const char* const GCS_PARAMS_FC_LIMIT          = "gcs.fc_limit";
+const char* const GCS_PARAMS_FC_SIZE_LIMIT     = "gcs.fc_size_limit";
 const char* const GCS_PARAMS_FC_MASTER_SLAVE   = "gcs.fc_master_slave";
+const char* const GCS_PARAMS_FC_RATE           = "gcs.fc_rate";
 const char* const GCS_PARAMS_FC_DEBUG          = "gcs.fc_debug";
 const char* const GCS_PARAMS_SYNC_DONOR        = "gcs.sync_donor";
 const char* const GCS_PARAMS_MAX_PKT_SIZE      = "gcs.max_packet_size";
@@ -22,7 +24,9 @@ const char* const GCS_PARAMS_MAX_THROTTLE      = "gcs.max_throttle";
 
 static const char* const GCS_PARAMS_FC_FACTOR_DEFAULT         = "1";
 static const char* const GCS_PARAMS_FC_LIMIT_DEFAULT          = "16";
+static const char* const GCS_PARAMS_FC_SIZE_LIMIT_DEFAULT     = "0"; // off
 static const char* const GCS_PARAMS_FC_MASTER_SLAVE_DEFAULT   = "no";
+static const char* const GCS_PARAMS_FC_RATE_DEFAULT           = "no";
 static const char* const GCS_PARAMS_FC_DEBUG_DEFAULT          = "0";
 static const char* const GCS_PARAMS_SYNC_DONOR_DEFAULT        = "no";
 static const char* const GCS_PARAMS_MAX_PKT_SIZE_DEFAULT      = "64500";
@@ -39,8 +43,12 @@ gcs_params_register(gu_config_t* conf)
                           GCS_PARAMS_FC_FACTOR_DEFAULT);
     ret |= gu_config_add (conf, GCS_PARAMS_FC_LIMIT,
                           GCS_PARAMS_FC_LIMIT_DEFAULT);
+    ret |= gu_config_add (conf, GCS_PARAMS_FC_SIZE_LIMIT,
+                          GCS_PARAMS_FC_SIZE_LIMIT_DEFAULT);
     ret |= gu_config_add (conf, GCS_PARAMS_FC_MASTER_SLAVE,
                           GCS_PARAMS_FC_MASTER_SLAVE_DEFAULT);
+    ret |= gu_config_add (conf, GCS_PARAMS_FC_RATE,
+                          GCS_PARAMS_FC_RATE_DEFAULT);
     ret |= gu_config_add (conf, GCS_PARAMS_FC_DEBUG,
                           GCS_PARAMS_FC_DEBUG_DEFAULT);
     ret |= gu_config_add (conf, GCS_PARAMS_SYNC_DONOR,
@@ -201,9 +209,16 @@ gcs_params_init (struct gcs_params* params, gu_config_t* config)
                                   &tmp))) return ret;
     params->recv_q_hard_limit = tmp * 0.9; // allow for some meta overhead
 
+    if ((ret = params_init_int64 (config, GCS_PARAMS_FC_SIZE_LIMIT, 0,
+                                  SSIZE_MAX, &tmp))) return ret;
+    params->fc_size_limit = tmp;
+
     if ((ret = params_init_bool (config, GCS_PARAMS_FC_MASTER_SLAVE,
                                  &params->fc_master_slave))) return ret;
 
+    if ((ret = params_init_bool (config, GCS_PARAMS_FC_RATE,
+                                 &params->fc_rate))) return ret;
+
     if ((ret = params_init_bool (config, GCS_PARAMS_SYNC_DONOR,
                                  &params->sync_donor))) return ret;
     return 0;
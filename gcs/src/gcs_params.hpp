@@ -14,16 +14,20 @@ struct gcs_params
     double  recv_q_soft_limit;
     double  max_throttle;
     ssize_t recv_q_hard_limit;
+    ssize_t fc_size_limit;
     long    fc_base_limit;
     long    max_packet_size;
     long    fc_debug;
     bool    fc_master_slave;
+    bool    fc_rate;
     bool    sync_donor;
 };
 
 extern const char* const GCS_PARAMS_FC_FACTOR;
 extern const char* const GCS_PARAMS_FC_LIMIT;
+extern const char* const GCS_PARAMS_FC_SIZE_LIMIT;
 extern const char* const GCS_PARAMS_FC_MASTER_SLAVE;
+extern const char* const GCS_PARAMS_FC_RATE;
 extern const char* const GCS_PARAMS_FC_DEBUG;
 extern const char* const GCS_PARAMS_SYNC_DONOR;
 extern const char* const GCS_PARAMS_MAX_PKT_SIZE;
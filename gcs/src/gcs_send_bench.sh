@@ -0,0 +1,33 @@
+#!/bin/bash -eu
+#
+# This script measures gcomm send throughput against the number of
+# concurrent sending threads. For each thread count it runs gcs_test on a
+# single node gcomm group and reports actions sent per second.
+#
+# NOTES:
+# - gcs_test must be built first (scons in the top source directory).
+# - Backend sends are serialized by the GCS core send lock and each of
+#   them takes the gcomm protonet lock, so this shows how much concurrent
+#   senders lose to contention on these locks.
+#
+# Usage: gcs_send_bench.sh
+# Environment: DURATION (seconds per run), THREADS (thread counts),
+#              ADDRESS (gmcast listen address)
+
+GCS_TEST=${GCS_TEST:-"$(dirname $0)/gcs_test"}
+DURATION=${DURATION:-"10"}
+THREADS=${THREADS:-"1 2 4 8 16 32"}
+ADDRESS=${ADDRESS:-"tcp://127.0.0.1:14567"}
+
+BACKEND="gcomm://0.0.0.0?gmcast.listen_addr=$ADDRESS"
+
+for threads in $THREADS
+do
+    # gcs_test waits for a key press before starting and before exiting;
+    # arguments: backend, duration, repl threads, send threads, recv threads
+    sent=$(printf '\n\n' | \
+           $GCS_TEST "$BACKEND" $DURATION 0 $threads 1 2>/dev/null | \
+           awk '/^Actions sent:/ { gsub(/[(]/, ""); print $4 }')
+
+    echo "threads: $threads actions/sec: $sent"
+done
@@ -45,6 +45,8 @@ gcs_sm_create (long len, long n)
 
     if (sm) {
         sm_init_stats (&sm->stats);
+        sm->send_q_hist = new gu::LogHistogram();
+        sm->paused_hist = new gu::LogHistogram();
         gu_mutex_init (&sm->lock, NULL);
 #ifdef GCS_SM_GRAB_RELEASE
         gu_cond_init  (&sm->cond, NULL);
@@ -131,6 +133,8 @@ gcs_sm_open (gcs_sm_t* sm)
 void
 gcs_sm_destroy (gcs_sm_t* sm)
 {
+    delete sm->send_q_hist;
+    delete sm->paused_hist;
     gu_mutex_destroy(&sm->lock);
     gu_free (sm);
 }
@@ -185,6 +189,16 @@ gcs_sm_stats_get (gcs_sm_t*  sm,
     }
 }
 
+void
+gcs_sm_stats_hist (gcs_sm_t*                   sm,
+                   gu::LogHistogram::Snapshot* send_q,
+                   gu::LogHistogram::Snapshot* paused)
+{
+    /* histograms are updated atomically, no need to lock */
+    sm->send_q_hist->snapshot(*send_q);
+    sm->paused_hist->snapshot(*paused);
+}
+
 void
 gcs_sm_stats_flush(gcs_sm_t* sm)
 {
@@ -206,6 +220,9 @@ gcs_sm_stats_flush(gcs_sm_t* sm)
     sm->stats.send_q_len_min = 0;
     sm->stats.send_q_samples = 0;
 
+    sm->send_q_hist->clear();
+    sm->paused_hist->clear();
+
     sm->users_max = sm->users;
     sm->users_min = sm->users;
     gu_mutex_unlock (&sm->lock);
@@ -12,6 +12,7 @@
 #define _gcs_sm_h_
 
 #include "gu_datetime.hpp"
+#include "gu_histogram.hpp"
 #include <galerautils.h>
 #include <errno.h>
 
@@ -44,6 +45,8 @@ gcs_sm_stats_t;
 typedef struct gcs_sm
 {
     gcs_sm_stats_t stats;
+    gu::LogHistogram* send_q_hist; // send queue length seen by new users
+    gu::LogHistogram* paused_hist; // FC pause durations (nanoseconds)
     gu_mutex_t    lock;
 #ifdef GCS_SM_GRAB_RELEASE
     gu_cond_t     cond;
@@ -260,6 +263,10 @@ gcs_sm_schedule (gcs_sm_t* sm)
 
             /* here we want to distinguish between FC pause and real queue */
             sm->stats.send_q_len += sm->users - 1;
+            sm->send_q_hist->insert(sm->users - 1);
+        }
+        else {
+            sm->send_q_hist->insert(0);
         }
 
         return ret; // success
@@ -372,7 +379,9 @@ gcs_sm_continue (gcs_sm_t* sm)
     if (gu_likely(sm->pause)) {
         _gcs_sm_continue_common (sm);
 
-        sm->stats.paused_ns += gu_time_monotonic() - sm->stats.pause_start;
+        long long const paused(gu_time_monotonic() - sm->stats.pause_start);
+        sm->stats.paused_ns += paused;
+        sm->paused_hist->insert(paused);
     }
     else {
         gu_debug ("Trying to continue unpaused monitor");
@@ -442,6 +451,13 @@ gcs_sm_stats_get (gcs_sm_t*  sm,
                   long long* paused_ns,
                   double*    paused_avg);
 
+/*! Takes snapshots of send queue length and FC pause duration
+ *  distributions since last flush */
+extern void
+gcs_sm_stats_hist (gcs_sm_t*                   sm,
+                   gu::LogHistogram::Snapshot* send_q,
+                   gu::LogHistogram::Snapshot* paused);
+
 /*! resets average/max/min stats calculation */
 extern void
 gcs_sm_stats_flush(gcs_sm_t* sm);
@@ -398,7 +398,7 @@ core_test_init (bool bootstrap = true,
 
 // cleans up core and backend objects
 static inline void
-core_test_cleanup ()
+core_test_cleanup (bool const closed = false)
 {
     long      ret;
     char      tmp[1];
@@ -409,9 +409,11 @@ core_test_cleanup ()
 
     // to fetch self-leave message
     fail_if (CORE_RECV_START (&act));
-    ret = gcs_core_close (Core);
-    fail_if (0 != ret, "Failed to close core: %ld (%s)",
-             ret, strerror (-ret));
+    if (!closed) {
+        ret = gcs_core_close (Core);
+        fail_if (0 != ret, "Failed to close core: %ld (%s)",
+                 ret, strerror (-ret));
+    }
     ret = CORE_RECV_END (&act, NULL, UNKNOWN_SIZE, GCS_ACT_CONF);
     fail_if (ret, "ret: %ld (%s)", ret, strerror(-ret));
     free (act.out);
@@ -927,6 +929,97 @@ END_TEST
 */
 
 
+static void*
+core_caused_thread (void* arg)
+{
+    *(gcs_seqno_t*)arg = gcs_core_caused (Core);
+    return (NULL);
+}
+
+// concurrent callers arriving while causal message is in flight must
+// share a single follow-up message
+START_TEST (gcs_core_test_caused)
+{
+    core_test_init ();
+
+    static int const N = 3;
+    gu_thread_t thr[N];
+    gcs_seqno_t seqno[N];
+    long long   calls, msgs;
+    action_t    act;
+
+    for (int i = 0; i < N; ++i) {
+        fail_if (gu_thread_create (&thr[i], NULL, core_caused_thread,
+                                   &seqno[i]));
+    }
+
+    // nobody receives messages yet, so the first causal message stays
+    // in flight until all callers have arrived
+    do {
+        usleep (1000);
+        gcs_core_caused_stats (Core, &calls, &msgs);
+    } while (calls < N);
+    fail_if (msgs != 1, "expected 1 causal message, got %lld", msgs);
+
+    // receive thread loops over causal messages until an action arrives
+    fail_if (CORE_RECV_START (&act));
+
+    for (int i = 0; i < N; ++i) {
+        fail_if (gu_thread_join (thr[i], NULL));
+        fail_if (seqno[i] != Seqno, "expected seqno %lld, got %lld",
+                 (long long)Seqno, (long long)seqno[i]);
+    }
+
+    gcs_core_caused_stats (Core, &calls, &msgs);
+    fail_if (calls != N);
+    fail_if (msgs != 2, "expected 2 causal messages, got %lld", msgs);
+
+    // release receive thread
+    fail_if (gcs_core_set_last_applied (Core, Seqno));
+    fail_if (CORE_RECV_END (&act, NULL, sizeof(gcs_seqno_t),
+                            GCS_ACT_COMMIT_CUT));
+    free (act.out);
+
+    core_test_cleanup ();
+}
+END_TEST
+
+// callers waiting for causal message must not hang when it is not
+// delivered because the connection is closed
+START_TEST (gcs_core_test_caused_close)
+{
+    core_test_init ();
+
+    static int const N = 3;
+    gu_thread_t thr[N];
+    gcs_seqno_t seqno[N];
+    long long   calls, msgs;
+
+    for (int i = 0; i < N; ++i) {
+        fail_if (gu_thread_create (&thr[i], NULL, core_caused_thread,
+                                   &seqno[i]));
+    }
+
+    do {
+        usleep (1000);
+        gcs_core_caused_stats (Core, &calls, &msgs);
+    } while (calls < N);
+
+    // nobody receives messages, so the only way out is close
+    long const ret = gcs_core_close (Core);
+    fail_if (0 != ret, "Failed to close core: %ld (%s)",
+             ret, strerror (-ret));
+
+    for (int i = 0; i < N; ++i) {
+        fail_if (gu_thread_join (thr[i], NULL));
+        fail_if (seqno[i] >= 0, "expected error, got %lld",
+                 (long long)seqno[i]);
+    }
+
+    core_test_cleanup (true);
+}
+END_TEST
+
 #if 0 // requires multinode support from gcs_dummy
 START_TEST (gcs_core_test_foreign)
 {
@@ -949,6 +1042,8 @@ Suite *gcs_core_suite(void)
   if (skip == false) {
       tcase_add_test  (tcase, gcs_core_test_api);
       tcase_add_test  (tcase, gcs_core_test_own);
+      tcase_add_test  (tcase, gcs_core_test_caused);
+      tcase_add_test  (tcase, gcs_core_test_caused_close);
       //  tcase_add_test  (tcase, gcs_core_test_foreign);
       // tcase_add_test (tcase, gcs_core_test_gh74);
   }
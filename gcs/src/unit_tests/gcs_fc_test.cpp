@@ -4,9 +4,12 @@
 
 #include "gcs_fc_test.hpp"
 #include "../gcs_fc.hpp"
+#include "../gcs.hpp"
 
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 START_TEST(gcs_fc_test_limits)
 {
@@ -120,6 +123,251 @@ START_TEST(gcs_fc_test_precise)
 }
 END_TEST
 
+START_TEST(gcs_fc_test_rate)
+{
+    gcs_fc_rate_t fc;
+
+    gcs_fc_rate_init (&fc);
+
+    /* no limit - no pacing */
+    fail_if (gcs_fc_rate_process (&fc, 1 << 20) != 0);
+
+    gcs_fc_rate_set (&fc, 1000000.0); // 1Mb/s
+
+    /* small action fits in the minimum sleep period */
+    fail_if (gcs_fc_rate_process (&fc, 100) != 0);
+
+    /* 100K more must take ~100 ms at this rate */
+    long long const pause = gcs_fc_rate_process (&fc, 100000);
+    fail_if (pause <= 90000000LL || pause > 100100000LL,
+             "Pause: %lld", pause);
+    fail_if (fc.paced_ns != pause);
+
+    /* disabling pacing takes effect immediately */
+    gcs_fc_rate_set (&fc, 0.0);
+    fail_if (gcs_fc_rate_process (&fc, 1 << 20) != 0);
+    fail_if (fc.paced_ns != pause);
+}
+END_TEST
+
+START_TEST(gcs_fc_test_sustainable)
+{
+    /* below lower limit no limit is needed */
+    fail_if (gcs_fc_rate_sustainable (1000000.0, 10, 10, 100) != 0.0);
+
+    /* just above lower limit - keep the queue steady */
+    double rate = gcs_fc_rate_sustainable (1000000.0, 11, 10, 100);
+    fail_if (rate > 1000000.0 || rate < 990000.0, "Rate: %f", rate);
+
+    /* half way */
+    rate = gcs_fc_rate_sustainable (1000000.0, 55, 10, 100);
+    fail_if (!double_equals (rate, 750000.0), "Rate: %f", rate);
+
+    /* above upper limit - drain the queue */
+    rate = gcs_fc_rate_sustainable (1000000.0, 1000, 10, 100);
+    fail_if (!double_equals (rate, 500000.0), "Rate: %f", rate);
+
+    /* stalled applier still lets replication trickle */
+    rate = gcs_fc_rate_sustainable (0.0, 1000, 10, 100);
+    fail_if (rate <= 0.0);
+}
+END_TEST
+
+/*
+ * Byte based STOP/CONT on a single node group over dummy backend. Actions
+ * sent by gcs_send() come back to the slave queue, so the test fills the
+ * queue by sending and drains it by receiving.
+ */
+
+static gu_config_t* fc_size_config = NULL;
+
+static gcs_conn_t*
+fc_size_open (const char* size_limit)
+{
+    fc_size_config = gu_config_create ();
+    fail_if (NULL == fc_size_config);
+    fail_if (gcs_register_params (fc_size_config));
+
+    gcs_conn_t* const conn = gcs_create (fc_size_config, NULL, "fc_size_test",
+                                         "", 0, 0);
+    fail_if (NULL == conn);
+
+    /* keep action count based limits out of the way */
+    fail_if (gcs_param_set (conn, "gcs.fc_limit", "1000"));
+    fail_if (gcs_param_set (conn, "gcs.fc_factor", "0.5"));
+    fail_if (gcs_param_set (conn, "gcs.fc_size_limit", size_limit));
+
+    long ret = gcs_open (conn, "fc_size_test", "dummy://", true);
+    fail_if (ret, "gcs_open(): %ld (%s)", ret, strerror(-ret));
+
+    struct gcs_action act;
+    ret = gcs_recv (conn, &act);
+    fail_if (ret <= 0 || GCS_ACT_CONF != act.type);
+    free (const_cast<void*>(act.buf));
+    fail_if (gcs_resume_recv (conn));
+
+    /* wait for SYNC, flow control is not in effect before that */
+    ret = gcs_recv (conn, &act);
+    fail_if (ret <= 0 || GCS_ACT_SYNC != act.type);
+    free (const_cast<void*>(act.buf));
+
+    ret = gcs_wait (conn);
+    fail_if (0 != ret, "gcs_wait(): %ld (%s)", ret, strerror(-ret));
+
+    return conn;
+}
+
+static void
+fc_size_close (gcs_conn_t* const conn)
+{
+    fail_if (gcs_close (conn));
+
+    /* fetch what is left in the slave queue */
+    struct gcs_action act;
+    while (gcs_recv (conn, &act) > 0) free (const_cast<void*>(act.buf));
+
+    fail_if (gcs_destroy (conn));
+    gu_config_destroy (fc_size_config);
+    fc_size_config = NULL;
+}
+
+/* sends an action and waits until it is in the slave queue */
+static void
+fc_size_send (gcs_conn_t* const conn, size_t const size)
+{
+    struct gcs_stats before, after;
+    gcs_get_stats (conn, &before);
+
+    void* const buf = calloc (1, size);
+    fail_if (NULL == buf);
+    long const ret = gcs_send (conn, buf, size, GCS_ACT_TORDERED, false);
+    fail_if (ret != long(size), "gcs_send(): %ld (%s)", ret, strerror(-ret));
+    free (buf);
+
+    do {
+        usleep (1000);
+        gcs_get_stats (conn, &after);
+    } while (after.recv_q_len <= before.recv_q_len);
+}
+
+static void
+fc_size_recv (gcs_conn_t* const conn, size_t const size)
+{
+    struct gcs_action act;
+    long const ret = gcs_recv (conn, &act);
+    fail_if (ret != long(size), "gcs_recv(): %ld (%s)", ret, strerror(-ret));
+    free (const_cast<void*>(act.buf));
+}
+
+/* waits for own FC message to come back, returns 1 if stopped */
+static long
+fc_size_wait (gcs_conn_t* const conn, long const expected)
+{
+    long ret;
+    for (int i = 0; i < 1000 && expected != (ret = gcs_wait (conn)); ++i) {
+        usleep (1000);
+    }
+    return ret;
+}
+
+START_TEST(gcs_fc_test_size_limit)
+{
+    gcs_conn_t* const conn = fc_size_open ("1000");
+    struct gcs_stats stats;
+
+    gcs_get_stats (conn, &stats);
+    fail_if (stats.fc_upper_size_limit != 1000);
+    fail_if (stats.fc_lower_size_limit != 500);
+
+    /* 900 bytes queued: below the limit, nothing is sent */
+    fc_size_send (conn, 300);
+    fc_size_send (conn, 300);
+    fc_size_send (conn, 300);
+    gcs_get_stats (conn, &stats);
+    fail_if (stats.recv_q_size != 900);
+    fail_if (stats.fc_sent != 0, "FC_STOP sent at %zu bytes",
+             stats.recv_q_size);
+    fail_if (gcs_wait (conn) != 0);
+
+    /* 1200 bytes queued: limit is crossed, STOP is sent */
+    fc_size_send (conn, 300);
+    gcs_get_stats (conn, &stats);
+    fail_if (stats.fc_sent != 1, "FC_STOP not sent at %zu bytes",
+             stats.recv_q_size);
+    fail_if (fc_size_wait (conn, 1) != 1);
+
+    /* 900 and 600 bytes left: above resume threshold, still stopped */
+    fc_size_recv (conn, 300);
+    fc_size_recv (conn, 300);
+    usleep (10000);
+    fail_if (gcs_wait (conn) != 1, "FC_CONT sent at 600 bytes");
+
+    /* 300 bytes left: below resume threshold, CONT is sent */
+    fc_size_recv (conn, 300);
+    fail_if (fc_size_wait (conn, 0) != 0, "FC_CONT not sent at 300 bytes");
+
+    fc_size_recv (conn, 300);
+    gcs_get_stats (conn, &stats);
+    fail_if (stats.fc_sent != 1);
+
+    fc_size_close (conn);
+}
+END_TEST
+
+START_TEST(gcs_fc_test_size_limit_edge)
+{
+    gcs_conn_t* const conn = fc_size_open ("1000");
+    struct gcs_stats stats;
+
+    /* exactly at the limit is not above it */
+    fc_size_send (conn, 500);
+    fc_size_send (conn, 500);
+    gcs_get_stats (conn, &stats);
+    fail_if (stats.fc_sent != 0, "FC_STOP sent at %zu bytes",
+             stats.recv_q_size);
+
+    /* a single byte more crosses it */
+    fc_size_send (conn, 1);
+    gcs_get_stats (conn, &stats);
+    fail_if (stats.fc_sent != 1, "FC_STOP not sent at %zu bytes",
+             stats.recv_q_size);
+    fail_if (fc_size_wait (conn, 1) != 1);
+
+    /* 501 bytes left: still above the resume threshold */
+    fc_size_recv (conn, 500);
+    usleep (10000);
+    fail_if (gcs_wait (conn) != 1, "FC_CONT sent at 501 bytes");
+
+    /* 1 byte left */
+    fc_size_recv (conn, 500);
+    fail_if (fc_size_wait (conn, 0) != 0, "FC_CONT not sent at 1 byte");
+
+    fc_size_recv (conn, 1);
+
+    fc_size_close (conn);
+}
+END_TEST
+
+START_TEST(gcs_fc_test_size_limit_off)
+{
+    gcs_conn_t* const conn = fc_size_open ("0");
+    struct gcs_stats stats;
+
+    /* without size limit any amount of bytes below action limit is fine */
+    for (int i = 0; i < 10; ++i) fc_size_send (conn, 10000);
+
+    gcs_get_stats (conn, &stats);
+    fail_if (stats.fc_upper_size_limit != 0);
+    fail_if (stats.fc_sent != 0, "FC_STOP sent at %zu bytes",
+             stats.recv_q_size);
+    fail_if (gcs_wait (conn) != 0);
+
+    for (int i = 0; i < 10; ++i) fc_size_recv (conn, 10000);
+
+    fc_size_close (conn);
+}
+END_TEST
+
 Suite *gcs_fc_suite(void)
 {
     Suite *s  = suite_create("GCS state transfer FC");
@@ -129,6 +377,14 @@ Suite *gcs_fc_suite(void)
     tcase_add_test  (tc, gcs_fc_test_limits);
     tcase_add_test  (tc, gcs_fc_test_basic);
     tcase_add_test  (tc, gcs_fc_test_precise);
+    tcase_add_test  (tc, gcs_fc_test_rate);
+    tcase_add_test  (tc, gcs_fc_test_sustainable);
+
+    tc = tcase_create("gcs_fc_size_limit");
+    suite_add_tcase (s, tc);
+    tcase_add_test  (tc, gcs_fc_test_size_limit);
+    tcase_add_test  (tc, gcs_fc_test_size_limit_edge);
+    tcase_add_test  (tc, gcs_fc_test_size_limit_off);
 
     return s;
 }
@@ -84,7 +84,7 @@ BuildRoot:	%(mktemp -ud %{_tmppath}/%{name}-%{version}-%{release}-XXXXXX)
 Provides: Percona-XtraDB-Cluster-galera-25 galera3
 Obsoletes: Percona-XtraDB-Cluster-galera-56 
 Conflicts: Percona-XtraDB-Cluster-galera-2
-BuildRequires:	scons check-devel glibc-devel %{gcc_req} openssl-devel %{boost_req} check-devel
+BuildRequires:	scons check-devel glibc-devel %{gcc_req} openssl-devel zlib-devel %{boost_req} check-devel
 
 %description
 This package contains the Galera library required by Percona XtraDB Cluster.
@@ -65,6 +65,7 @@ BuildRequires: check-devel
 BuildRequires: glibc-devel
 BuildRequires: openssl-devel
 BuildRequires: scons
+BuildRequires: zlib-devel
 %if 0%{?suse_version} == 1110
 # On SLES11 SPx use the linked gcc47 to build instead of default gcc43
 BuildRequires: gcc47 gcc47-c++
@@ -0,0 +1,47 @@
+#!/bin/bash -eu
+
+# This test measures causal read throughput against the number of reader
+# threads. For each thread count it runs causal utility (see causal.cpp)
+# and reports causal reads per second together with the number of causal
+# read messages sent to the group per read.
+#
+# NOTES:
+# - Concurrent causal reads on the same node share group round-trips, so
+#   messages per read should fall well below 1 as the thread count grows.
+# - causal utility must be built first (scons in this directory).
+
+declare -r DIST_BASE=$(cd $(dirname $0)/..; pwd -P)
+TEST_BASE=${TEST_BASE:-"$DIST_BASE"}
+
+. $TEST_BASE/conf/main.conf
+
+USER="test"
+PSWD="testpass"
+
+DURATION=${DURATION:-"10"}
+THREADS=${THREADS:-"1 2 4 8 16 32 64 128 256"}
+
+READ_HOST="${NODE_INCOMING_HOST[0]}:${NODE_INCOMING_PORT[0]}"
+WRITE_HOST="${NODE_INCOMING_HOST[1]}:${NODE_INCOMING_PORT[1]}"
+
+MYSQL="mysql -u$USER -p$PSWD"
+MYSQL="$MYSQL -h${NODE_INCOMING_HOST[0]} -P${NODE_INCOMING_PORT[0]} -B -N"
+
+causal_read_msgs()
+{
+    $MYSQL -e "SHOW STATUS LIKE 'wsrep_causal_read_msgs'" | cut -f 2
+}
+
+for threads in $THREADS
+do
+    msgs_before=$(causal_read_msgs)
+    reads=$($(dirname $0)/causal --read-host $READ_HOST \
+                                 --write-host $WRITE_HOST \
+                                 --user $USER --password $PSWD \
+                                 --duration $DURATION --readers $threads \
+                                 --compact true | awk '{ print $2 }')
+    msgs=$(( $(causal_read_msgs) - $msgs_before ))
+
+    echo "threads: $threads reads/sec: $(( $reads / $DURATION ))" \
+         "msgs/read: $(echo "scale=3; $msgs / ($reads + 1)" | bc)"
+done
@@ -0,0 +1,73 @@
+#!/bin/bash -eu
+
+# This test measures commit latency of large transactions replicated with
+# default and with large group communication message sizes.
+#
+# Each run restarts the cluster with given provider options, then commits
+# a number of transactions, each inserting TRX_SIZE bytes in BLOB_SIZE
+# rows, and reports average commit time.
+#
+# NOTES:
+# - Large messages require gmcast.version=1 on all nodes. gcs.max_packet_size
+#   must be raised too, otherwise write sets are still fragmented at 64KB.
+# - Server max_allowed_packet and wsrep_max_ws_size must fit TRX_SIZE.
+
+declare -r DIST_BASE=$(cd $(dirname $0)/..; pwd -P)
+TEST_BASE=${TEST_BASE:-"$DIST_BASE"}
+
+. $TEST_BASE/conf/main.conf
+
+declare -r SCRIPTS="$DIST_BASE/scripts"
+. $SCRIPTS/jobs.sh
+. $SCRIPTS/action.sh
+
+declare -r TABLE="$DBMS_TEST_SCHEMA.large_trx"
+declare -r TABLE_DEFINITION="(pk INT AUTO_INCREMENT PRIMARY KEY, b LONGBLOB)"
+
+TRX_SIZE=${TRX_SIZE:-"104857600"}   # 100MB
+BLOB_SIZE=${BLOB_SIZE:-"1048576"}   # 1MB
+TRX_NUM=${TRX_NUM:-"10"}
+
+declare -r DEFAULT_OPTS=""
+declare -r LARGE_OPTS="gmcast.version=1;gmcast.max_message_size=4194304;gcs.max_packet_size=4194304"
+
+MYSQL="mysql -u$DBMS_TEST_USER -p$DBMS_TEST_PSWD"
+MYSQL="$MYSQL -h${NODE_INCOMING_HOST[0]} -P${NODE_INCOMING_PORT[0]} -B"
+
+trx_load()
+{
+    local -r rows=$(( $TRX_SIZE / $BLOB_SIZE ))
+    echo "BEGIN; "
+    for i in $(seq 1 $rows)
+    do
+        echo "INSERT INTO $TABLE (b) VALUES (REPEAT('x', $BLOB_SIZE)); "
+    done
+    echo "COMMIT; "
+}
+
+run()
+{
+    local -r opts="$1"
+
+    stop
+    start "--mysql-opt --wsrep-provider-options='$opts'"
+
+    $MYSQL -e "DROP TABLE IF EXISTS $TABLE"
+    $MYSQL -e "CREATE TABLE $TABLE $TABLE_DEFINITION"
+
+    local total=0
+    for i in $(seq 1 $TRX_NUM)
+    do
+        local start=$(date +%s%N)
+        trx_load | $MYSQL
+        total=$(( $total + $(date +%s%N) - $start ))
+        $MYSQL -e "TRUNCATE TABLE $TABLE"
+    done
+
+    echo "'$opts': $(( $total / $TRX_NUM / 1000000 )) ms per transaction"
+}
+
+run "$DEFAULT_OPTS"
+run "$LARGE_OPTS"
+
+stop